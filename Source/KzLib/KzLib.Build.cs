@@ -12,7 +12,8 @@ public class KzLib : ModuleRules
 			new string[]
 			{
 				"Core",
-				"GameplayTags"
+				"GameplayTags",
+				"NetCore"
 			}
 			);
 
@@ -24,8 +25,7 @@ public class KzLib : ModuleRules
 				"Slate",
 				"SlateCore",
 				"RenderCore",
-				"Projects",
-				"NetCore"
+				"Projects"
 			}
 			);
 
@@ -1,6 +1,7 @@
 // Copyright 2026 kirzo
 
 #include "Components/KzDatabaseComponent.h"
+#include "Engine/World.h"
 
 #if WITH_EDITOR
 #include "Misc/MessageDialog.h"
@@ -15,17 +16,22 @@ void UKzDatabaseComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Autowire the Backend Map for O(1) lookups
-	DatabaseMap.Empty(Databases.Num());
+	// Autowire the Backend Context for array-index lookups
+	if (UKzDatabaseResolverSubsystem* Resolver = UWorld::GetSubsystem<UKzDatabaseResolverSubsystem>(GetWorld()))
+	{
+		Context = Resolver->RegisterComponent(this);
+	}
+}
 
-	for (UKzDatabaseAsset* Asset : Databases)
+void UKzDatabaseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Context = nullptr;
+	if (UKzDatabaseResolverSubsystem* Resolver = UWorld::GetSubsystem<UKzDatabaseResolverSubsystem>(GetWorld()))
 	{
-		if (Asset && Asset->Database.Type.IsValid())
-		{
-			// The key is the schema type, the value is the asset
-			DatabaseMap.Add(Asset->GetDataType(), Asset);
-		}
+		Resolver->UnregisterComponent(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 #if WITH_EDITOR
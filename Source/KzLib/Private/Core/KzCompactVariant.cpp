@@ -0,0 +1,362 @@
+// Copyright 2026 kirzo
+
+#include "Core/KzCompactVariant.h"
+
+namespace KzCompactVariant
+{
+	/** Allocates the default-initialized heap value of a String, Text, Struct, SoftObject or SoftClass variant. */
+	static void* AllocateHeap(EPropertyBagPropertyType Type, const UScriptStruct* Struct)
+	{
+		switch (Type)
+		{
+			case EPropertyBagPropertyType::String:			return new FString();
+			case EPropertyBagPropertyType::Text:				return new FText();
+			case EPropertyBagPropertyType::SoftObject:	return new TSoftObjectPtr<UObject>();
+			case EPropertyBagPropertyType::SoftClass:		return new TSoftClassPtr<UObject>();
+			case EPropertyBagPropertyType::Struct:
+			{
+				if (!Struct)
+				{
+					return nullptr;
+				}
+
+				void* Memory = FMemory::Malloc(FMath::Max(1, Struct->GetStructureSize()), Struct->GetMinAlignment());
+				Struct->InitializeStruct(Memory);
+				return Memory;
+			}
+			default:																		return nullptr;
+		}
+	}
+
+	static void FreeHeap(EPropertyBagPropertyType Type, const UScriptStruct* Struct, void* Memory)
+	{
+		switch (Type)
+		{
+			case EPropertyBagPropertyType::String:			delete static_cast<FString*>(Memory); break;
+			case EPropertyBagPropertyType::Text:				delete static_cast<FText*>(Memory); break;
+			case EPropertyBagPropertyType::SoftObject:	delete static_cast<TSoftObjectPtr<UObject>*>(Memory); break;
+			case EPropertyBagPropertyType::SoftClass:		delete static_cast<TSoftClassPtr<UObject>*>(Memory); break;
+			case EPropertyBagPropertyType::Struct:
+			{
+				Struct->DestroyStruct(Memory);
+				FMemory::Free(Memory);
+				break;
+			}
+			default: break;
+		}
+	}
+
+	/** Copies a value between two GetData pointers (FKzVariant or FKzCompactVariant) of the same type. */
+	static void CopyValue(EPropertyBagPropertyType Type, const UObject* TypeObject, void* Dest, const void* Src)
+	{
+		switch (Type)
+		{
+			case EPropertyBagPropertyType::Bool:				*static_cast<bool*>(Dest) = *static_cast<const bool*>(Src); break;
+			case EPropertyBagPropertyType::Byte:				*static_cast<uint8*>(Dest) = *static_cast<const uint8*>(Src); break;
+			case EPropertyBagPropertyType::Int32:				*static_cast<int32*>(Dest) = *static_cast<const int32*>(Src); break;
+			case EPropertyBagPropertyType::Enum:
+			case EPropertyBagPropertyType::Int64:				*static_cast<int64*>(Dest) = *static_cast<const int64*>(Src); break;
+			case EPropertyBagPropertyType::Float:
+			case EPropertyBagPropertyType::Double:			*static_cast<double*>(Dest) = *static_cast<const double*>(Src); break;
+			case EPropertyBagPropertyType::Name:				*static_cast<FName*>(Dest) = *static_cast<const FName*>(Src); break;
+			case EPropertyBagPropertyType::String:			*static_cast<FString*>(Dest) = *static_cast<const FString*>(Src); break;
+			case EPropertyBagPropertyType::Text:				*static_cast<FText*>(Dest) = *static_cast<const FText*>(Src); break;
+			case EPropertyBagPropertyType::Struct:			CastChecked<UScriptStruct>(TypeObject)->CopyScriptStruct(Dest, Src); break;
+			case EPropertyBagPropertyType::Object:			*static_cast<TObjectPtr<UObject>*>(Dest) = *static_cast<const TObjectPtr<UObject>*>(Src); break;
+			case EPropertyBagPropertyType::SoftObject:	*static_cast<TSoftObjectPtr<UObject>*>(Dest) = *static_cast<const TSoftObjectPtr<UObject>*>(Src); break;
+			case EPropertyBagPropertyType::Class:				*static_cast<TObjectPtr<UClass>*>(Dest) = *static_cast<const TObjectPtr<UClass>*>(Src); break;
+			case EPropertyBagPropertyType::SoftClass:		*static_cast<TSoftClassPtr<UObject>*>(Dest) = *static_cast<const TSoftClassPtr<UObject>*>(Src); break;
+			default: break;
+		}
+	}
+
+	/** The type object a compact variant keeps for a type: enums, structs and the expected class of soft references. */
+	static const UObject* GetStoredTypeObject(EPropertyBagPropertyType Type, const UObject* TypeObject)
+	{
+		switch (Type)
+		{
+			case EPropertyBagPropertyType::Enum:				return Cast<UEnum>(TypeObject);
+			case EPropertyBagPropertyType::Struct:			return Cast<UScriptStruct>(TypeObject);
+			case EPropertyBagPropertyType::SoftObject:
+			case EPropertyBagPropertyType::SoftClass:		return Cast<UClass>(TypeObject);
+			default:																		return nullptr;
+		}
+	}
+}
+
+FKzCompactVariant::FKzCompactVariant(const FKzCompactVariant& Other)
+{
+	*this = Other;
+}
+
+FKzCompactVariant::FKzCompactVariant(FKzCompactVariant&& Other)
+{
+	*this = MoveTemp(Other);
+}
+
+FKzCompactVariant& FKzCompactVariant::operator=(const FKzCompactVariant& Other)
+{
+	if (this != &Other)
+	{
+		PrepareType(Other.Type, Other.GetTypeObject());
+		if (const void* Src = Other.GetData())
+		{
+			KzCompactVariant::CopyValue(Type, TypeObject, GetData(), Src);
+		}
+	}
+	return *this;
+}
+
+FKzCompactVariant& FKzCompactVariant::operator=(FKzCompactVariant&& Other)
+{
+	if (this != &Other)
+	{
+		// The payload is trivially relocatable: inline values are bytes, heap values a pointer.
+		Reset();
+		Type = Other.Type;
+		TypeObject = Other.TypeObject;
+		Storage = Other.Storage;
+
+		Other.Type = EPropertyBagPropertyType::None;
+		Other.TypeObject = nullptr;
+		FMemory::Memzero(Other.Storage);
+	}
+	return *this;
+}
+
+void FKzCompactVariant::Reset()
+{
+	if (UsesHeap(Type) && Storage.HeapValue)
+	{
+		KzCompactVariant::FreeHeap(Type, GetScriptStruct(), Storage.HeapValue);
+	}
+
+	// Inline FName and TObjectPtr values are trivially destructible.
+	Type = EPropertyBagPropertyType::None;
+	TypeObject = nullptr;
+	FMemory::Memzero(Storage);
+}
+
+void FKzCompactVariant::SetType(EPropertyBagPropertyType NewType, const UObject* NewTypeObject)
+{
+	Reset();
+	Type = NewType;
+	TypeObject = const_cast<UObject*>(KzCompactVariant::GetStoredTypeObject(NewType, NewTypeObject));
+
+	switch (NewType)
+	{
+		case EPropertyBagPropertyType::Name:				new (Storage.NameValue.GetTypedPtr()) FName(); break;
+		case EPropertyBagPropertyType::Object:			new (Storage.ObjectValue.GetTypedPtr()) TObjectPtr<UObject>(); break;
+		case EPropertyBagPropertyType::Class:
+		{
+			// Seeded with the class itself, as FKzVariant does.
+			new (Storage.ClassValue.GetTypedPtr()) TObjectPtr<UClass>(const_cast<UClass*>(Cast<UClass>(NewTypeObject)));
+			break;
+		}
+		case EPropertyBagPropertyType::Enum:
+		{
+			const UEnum* Enum = Cast<UEnum>(NewTypeObject);
+			if (Enum && Enum->NumEnums() > 1)
+			{
+				Storage.Int64Value = Enum->GetValueByIndex(0);
+			}
+			break;
+		}
+		default:
+		{
+			if (UsesHeap(NewType))
+			{
+				Storage.HeapValue = KzCompactVariant::AllocateHeap(NewType, GetScriptStruct());
+			}
+			break;
+		}
+	}
+}
+
+void FKzCompactVariant::PrepareType(EPropertyBagPropertyType NewType, const UObject* NewTypeObject)
+{
+	if (Type != NewType || TypeObject != KzCompactVariant::GetStoredTypeObject(NewType, NewTypeObject) || (NewType == EPropertyBagPropertyType::Struct && !Storage.HeapValue))
+	{
+		SetType(NewType, NewTypeObject);
+	}
+}
+
+const UObject* FKzCompactVariant::GetTypeObject() const
+{
+	switch (Type)
+	{
+		case EPropertyBagPropertyType::Object:
+		{
+			const UObject* Object = As<TObjectPtr<UObject>>().Get();
+			return Object ? Object->GetClass() : nullptr;
+		}
+		case EPropertyBagPropertyType::Class:				return As<TObjectPtr<UClass>>().Get();
+		default:																		return TypeObject;
+	}
+}
+
+void* FKzCompactVariant::GetData()
+{
+	switch (Type)
+	{
+		case EPropertyBagPropertyType::None:				return nullptr;
+		case EPropertyBagPropertyType::Bool:				return &Storage.BoolValue;
+		case EPropertyBagPropertyType::Byte:				return &Storage.ByteValue;
+		case EPropertyBagPropertyType::Int32:				return &Storage.Int32Value;
+		case EPropertyBagPropertyType::Enum:
+		case EPropertyBagPropertyType::Int64:				return &Storage.Int64Value;
+		case EPropertyBagPropertyType::Float:
+		case EPropertyBagPropertyType::Double:			return &Storage.DoubleValue;
+		case EPropertyBagPropertyType::Name:				return Storage.NameValue.GetTypedPtr();
+		case EPropertyBagPropertyType::Object:			return Storage.ObjectValue.GetTypedPtr();
+		case EPropertyBagPropertyType::Class:				return Storage.ClassValue.GetTypedPtr();
+		default:																		return UsesHeap(Type) ? Storage.HeapValue : nullptr;
+	}
+}
+
+const void* FKzCompactVariant::GetData() const
+{
+	return const_cast<FKzCompactVariant*>(this)->GetData();
+}
+
+void FKzCompactVariant::CopyFrom(const FKzVariant& Variant)
+{
+	PrepareType(Variant.GetType(), Variant.GetTypeObject());
+
+	const void* Src = Variant.GetData();
+	void* Dest = GetData();
+	if (Src && Dest)
+	{
+		KzCompactVariant::CopyValue(Type, TypeObject, Dest, Src);
+	}
+}
+
+void FKzCompactVariant::CopyTo(FKzVariant& Variant) const
+{
+	Variant.SetType(Type, GetTypeObject());
+
+	const void* Src = GetData();
+	void* Dest = Variant.GetData();
+	if (Src && Dest)
+	{
+		KzCompactVariant::CopyValue(Type, TypeObject, Dest, Src);
+	}
+}
+
+FKzVariant FKzCompactVariant::ToVariant() const
+{
+	FKzVariant Variant;
+	CopyTo(Variant);
+	return Variant;
+}
+
+bool FKzCompactVariant::MatchesType(const FKzTypeDef& TypeDef) const
+{
+	if (TypeDef.ContainerType != EPropertyBagContainerType::None) { return false; }
+
+	if (Type != TypeDef.ValueType) { return false; }
+
+	// Same rules as FKzVariant::MatchesType.
+	const UObject* HeldTypeObj = GetTypeObject();
+	const UObject* ExpectedTypeObj = TypeDef.ValueTypeObject;
+
+	if (!ExpectedTypeObj && !HeldTypeObj) { return true; }
+	if (!ExpectedTypeObj || !HeldTypeObj) { return false; }
+
+	if (Type == EPropertyBagPropertyType::Object || Type == EPropertyBagPropertyType::SoftObject || Type == EPropertyBagPropertyType::Class || Type == EPropertyBagPropertyType::SoftClass)
+	{
+		const UClass* ExpectedClass = Cast<UClass>(ExpectedTypeObj);
+		const UClass* HeldClass = Cast<UClass>(HeldTypeObj);
+		return ExpectedClass && HeldClass && HeldClass->IsChildOf(ExpectedClass);
+	}
+
+	return ExpectedTypeObj == HeldTypeObj;
+}
+
+bool FKzCompactVariant::Serialize(FArchive& Ar)
+{
+	// Stored as the equivalent FKzVariant, so both types share one on-disk format.
+	FKzVariant Variant;
+	if (!Ar.IsLoading())
+	{
+		CopyTo(Variant);
+	}
+
+	FKzVariant::StaticStruct()->SerializeItem(Ar, &Variant, nullptr);
+
+	if (Ar.IsLoading())
+	{
+		CopyFrom(Variant);
+	}
+	return true;
+}
+
+bool FKzCompactVariant::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	FKzVariant Variant;
+	if (Ar.IsSaving())
+	{
+		CopyTo(Variant);
+	}
+
+	Variant.NetSerialize(Ar, Map, bOutSuccess);
+
+	if (Ar.IsLoading())
+	{
+		CopyFrom(Variant);
+	}
+	return true;
+}
+
+void FKzCompactVariant::AddStructReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(TypeObject);
+
+	switch (Type)
+	{
+		case EPropertyBagPropertyType::Object:			Collector.AddReferencedObject(As<TObjectPtr<UObject>>()); break;
+		case EPropertyBagPropertyType::Class:				Collector.AddReferencedObject(As<TObjectPtr<UClass>>()); break;
+		case EPropertyBagPropertyType::Struct:
+		{
+			if (Storage.HeapValue)
+			{
+				Collector.AddPropertyReferencesWithStructARO(GetScriptStruct(), Storage.HeapValue);
+			}
+			break;
+		}
+		default: break;
+	}
+}
+
+bool FKzCompactVariant::operator==(const FKzCompactVariant& Other) const
+{
+	if (Type != Other.Type || TypeObject != Other.TypeObject) return false;
+
+	switch (Type)
+	{
+		case EPropertyBagPropertyType::None:				return true;
+		case EPropertyBagPropertyType::Bool:				return Storage.BoolValue == Other.Storage.BoolValue;
+		case EPropertyBagPropertyType::Byte:				return Storage.ByteValue == Other.Storage.ByteValue;
+		case EPropertyBagPropertyType::Int32:				return Storage.Int32Value == Other.Storage.Int32Value;
+		case EPropertyBagPropertyType::Enum:
+		case EPropertyBagPropertyType::Int64:				return Storage.Int64Value == Other.Storage.Int64Value;
+		case EPropertyBagPropertyType::Float:
+		case EPropertyBagPropertyType::Double:			return Storage.DoubleValue == Other.Storage.DoubleValue;
+		case EPropertyBagPropertyType::Name:				return As<FName>() == Other.As<FName>();
+		case EPropertyBagPropertyType::String:			return As<FString>() == Other.As<FString>();
+		case EPropertyBagPropertyType::Text:				return As<FText>().EqualTo(Other.As<FText>());
+		case EPropertyBagPropertyType::Struct:
+		{
+			if (!Storage.HeapValue || !Other.Storage.HeapValue)
+			{
+				return Storage.HeapValue == Other.Storage.HeapValue;
+			}
+			return GetScriptStruct()->CompareScriptStruct(Storage.HeapValue, Other.Storage.HeapValue, PPF_None);
+		}
+		case EPropertyBagPropertyType::Object:			return As<TObjectPtr<UObject>>() == Other.As<TObjectPtr<UObject>>();
+		case EPropertyBagPropertyType::SoftObject:	return As<TSoftObjectPtr<UObject>>() == Other.As<TSoftObjectPtr<UObject>>();
+		case EPropertyBagPropertyType::Class:				return As<TObjectPtr<UClass>>() == Other.As<TObjectPtr<UClass>>();
+		case EPropertyBagPropertyType::SoftClass:		return As<TSoftClassPtr<UObject>>() == Other.As<TSoftClassPtr<UObject>>();
+		default:																		return false;
+	}
+}
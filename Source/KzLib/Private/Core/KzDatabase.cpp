@@ -2,6 +2,9 @@
 
 #include "Core/KzDatabase.h"
 #include "Algo/Count.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeRWLock.h"
 
 bool FKzDatabaseQuery::Matches(const FGameplayTagContainer& Tags) const
 {
@@ -33,7 +36,7 @@ int32 FKzDatabaseQuery::CalculateScore(const FGameplayTagContainer& Tags) const
 		return 0;
 	}
 	// Count how many optional tags are present in the item
-  return Algo::CountIf(OptionalTags, [Tags](const FGameplayTag& OptionalTag) { return OptionalTag.MatchesAnyExact(Tags); });
+	return Algo::CountIf(OptionalTags, [&Tags](const FGameplayTag& OptionalTag) { return OptionalTag.MatchesAnyExact(Tags); });
 }
 
 bool FKzDatabaseQuery::IsEmpty() const
@@ -49,14 +52,898 @@ void FKzDatabaseItem::SyncType(const FKzTypeDef& TypeDef)
 	}
 }
 
+void FKzDatabaseTagIndex::Build(const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision)
+{
+	Postings.Reset();
+	TagBits.Reset();
+	BitTags.Reset();
+
+	// Items are visited in order, so every posting list comes out sorted and unique.
+	TArray<FGameplayTagContainer> Expanded;
+	Expanded.Reserve(Items.Num());
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		for (const FGameplayTag& Tag : Expanded.Add_GetRef(Items[Index].Tags.GetGameplayTagParents()))
+		{
+			Postings.FindOrAdd(Tag).Add(Index);
+			if (!TagBits.Contains(Tag))
+			{
+				TagBits.Add(Tag, BitTags.Add(Tag));
+			}
+		}
+	}
+
+	NumWords = FMath::DivideAndRoundUp(TagBits.Num(), 64);
+	ItemBits.SetNumZeroed(Items.Num() * NumWords);
+	ExactBits.SetNumZeroed(Items.Num() * NumWords);
+
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		uint64* Bits = ItemBits.GetData() + Index * NumWords;
+		for (const FGameplayTag& Tag : Expanded[Index])
+		{
+			const int32 Bit = TagBits.FindChecked(Tag);
+			Bits[Bit >> 6] |= uint64(1) << (Bit & 63);
+		}
+
+		uint64* Exact = ExactBits.GetData() + Index * NumWords;
+		for (const FGameplayTag& Tag : Items[Index].Tags)
+		{
+			const int32 Bit = TagBits.FindChecked(Tag);
+			Exact[Bit >> 6] |= uint64(1) << (Bit & 63);
+		}
+	}
+
+	NumIndexed = Items.Num();
+	ItemRevision = InItemRevision;
+	++Revision;
+}
+
+void FKzDatabaseTagIndex::Serialize(FArchive& Ar, int32 NumItems, uint32 InItemRevision)
+{
+	// Tag names ordered by bit.
+	TArray<FName> TagNames;
+	if (Ar.IsSaving())
+	{
+		check(NumIndexed == NumItems);
+		TagNames.Reserve(BitTags.Num());
+		for (const FGameplayTag& Tag : BitTags)
+		{
+			TagNames.Add(Tag.GetTagName());
+		}
+	}
+
+	Ar << TagNames;
+	Ar << NumWords;
+	ItemBits.BulkSerialize(Ar);
+	ExactBits.BulkSerialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		Postings.Reset();
+		TagBits.Reset();
+		BitTags.Reset();
+
+		for (int32 Bit = 0; Bit < TagNames.Num(); ++Bit)
+		{
+			// A tag removed from the project since cooking keeps its bit but resolves to no tag.
+			const FGameplayTag Tag = FGameplayTag::RequestGameplayTag(TagNames[Bit], false);
+			BitTags.Add(Tag);
+			if (Tag.IsValid())
+			{
+				TagBits.Add(Tag, Bit);
+			}
+		}
+
+		// Items are visited in order, so every posting list comes out sorted.
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			const uint64* Bits = GetItemBits(Index);
+			for (int32 Word = 0; Word < NumWords; ++Word)
+			{
+				for (uint64 Remaining = Bits[Word]; Remaining != 0; Remaining &= Remaining - 1)
+				{
+					const int32 Bit = Word * 64 + int32(FMath::CountTrailingZeros64(Remaining));
+					if (BitTags[Bit].IsValid())
+					{
+						Postings.FindOrAdd(BitTags[Bit]).Add(Index);
+					}
+				}
+			}
+		}
+
+		NumIndexed = NumItems;
+		ItemRevision = InItemRevision;
+		++Revision;
+	}
+}
+
+namespace KzDatabase
+{
+	template <typename T>
+	struct TColumnType
+	{
+		using Type = T;
+	};
+
+	/** Calls Func with the column element type of a non-struct bag type. Returns false for unsupported types. */
+	template <typename FuncType>
+	static bool DispatchColumnType(EPropertyBagPropertyType Type, FuncType&& Func)
+	{
+		switch (Type)
+		{
+			case EPropertyBagPropertyType::Bool:				Func(TColumnType<bool>()); return true;
+			case EPropertyBagPropertyType::Byte:				Func(TColumnType<uint8>()); return true;
+			case EPropertyBagPropertyType::Enum:				Func(TColumnType<int64>()); return true;
+			case EPropertyBagPropertyType::Int32:				Func(TColumnType<int32>()); return true;
+			case EPropertyBagPropertyType::Int64:				Func(TColumnType<int64>()); return true;
+			case EPropertyBagPropertyType::Float:				Func(TColumnType<float>()); return true;
+			case EPropertyBagPropertyType::Double:			Func(TColumnType<double>()); return true;
+			case EPropertyBagPropertyType::Name:				Func(TColumnType<FName>()); return true;
+			case EPropertyBagPropertyType::String:			Func(TColumnType<FString>()); return true;
+			case EPropertyBagPropertyType::Text:				Func(TColumnType<FText>()); return true;
+			case EPropertyBagPropertyType::Object:			Func(TColumnType<TObjectPtr<UObject>>()); return true;
+			case EPropertyBagPropertyType::SoftObject:	Func(TColumnType<TSoftObjectPtr<UObject>>()); return true;
+			case EPropertyBagPropertyType::Class:				Func(TColumnType<TObjectPtr<UClass>>()); return true;
+			case EPropertyBagPropertyType::SoftClass:		Func(TColumnType<TSoftClassPtr<UObject>>()); return true;
+			default:																		return false;
+		}
+	}
+
+	/** Keeps the entries of InOut that are also in Other. Both lists are sorted ascending. */
+	static void IntersectSorted(TArray<int32>& InOut, const TArray<int32>& Other)
+	{
+		int32 Write = 0;
+		for (int32 Read = 0, OtherIndex = 0; Read < InOut.Num() && OtherIndex < Other.Num();)
+		{
+			if (InOut[Read] < Other[OtherIndex])
+			{
+				++Read;
+			}
+			else if (Other[OtherIndex] < InOut[Read])
+			{
+				++OtherIndex;
+			}
+			else
+			{
+				InOut[Write++] = InOut[Read++];
+				++OtherIndex;
+			}
+		}
+		InOut.SetNum(Write, EAllowShrinking::No);
+	}
+
+	static void SetBit(TArray<uint64, TInlineAllocator<4>>& Mask, int32 Bit)
+	{
+		Mask[Bit >> 6] |= uint64(1) << (Bit & 63);
+	}
+
+	struct FRankedItem
+	{
+		int32 Index;
+		int32 Score;
+	};
+
+	/** Ranking order of query results: higher score first, then item order. */
+	static bool IsBetter(const FRankedItem& A, const FRankedItem& B)
+	{
+		return A.Score != B.Score ? A.Score > B.Score : A.Index < B.Index;
+	}
+
+	/** Best K matches of Query, sorted by IsBetter. */
+	static void CollectTopK(const FKzDatabase& Database, const FKzDatabaseQuery& Query, int32 K, TArray<FRankedItem>& OutRanked)
+	{
+		OutRanked.Reset();
+		if (K <= 0)
+		{
+			return;
+		}
+
+		// Bounded heap with the worst kept match on top.
+		auto IsWorse = [](const FRankedItem& A, const FRankedItem& B) { return IsBetter(B, A); };
+		const FKzDatabaseItem* First = Database.Items.GetData();
+
+		Database.ForEachMatch(Query, [&OutRanked, &IsWorse, K, First](const FKzDatabaseItem& Item, int32 Score)
+		{
+			const FRankedItem Entry{ int32(&Item - First), Score };
+			if (OutRanked.Num() < K)
+			{
+				OutRanked.HeapPush(Entry, IsWorse);
+			}
+			else if (IsBetter(Entry, OutRanked.HeapTop()))
+			{
+				OutRanked.HeapPopDiscard(IsWorse, EAllowShrinking::No);
+				OutRanked.HeapPush(Entry, IsWorse);
+			}
+			return true;
+		});
+
+		OutRanked.Sort(IsBetter);
+	}
+}
+
+void FKzDatabaseTagProgram::Compile(const FGameplayTagQuery& Query, const FKzDatabaseTagIndex& Index)
+{
+	Code.Reset();
+	Masks.Reset();
+	NumWords = Index.NumWords;
+	Revision = Index.Revision;
+
+	if (!Query.IsEmpty())
+	{
+		FGameplayTagQueryExpression Expr;
+		Query.GetQueryExpr(Expr);
+		Emit(Expr, Index);
+	}
+}
+
+void FKzDatabaseTagProgram::Emit(const FGameplayTagQueryExpression& Expr, const FKzDatabaseTagIndex& Index)
+{
+	switch (Expr.ExprType)
+	{
+	case EGameplayTagQueryExprType::AnyTagsMatch:		EmitTags(EOp::AnyTags, false, false, Expr.TagSet, Index); return;
+	case EGameplayTagQueryExprType::AllTagsMatch:		EmitTags(EOp::AllTags, false, false, Expr.TagSet, Index); return;
+	case EGameplayTagQueryExprType::NoTagsMatch:		EmitTags(EOp::AnyTags, false, true, Expr.TagSet, Index); return;
+	case EGameplayTagQueryExprType::AnyTagsExactMatch:	EmitTags(EOp::AnyTags, true, false, Expr.TagSet, Index); return;
+	case EGameplayTagQueryExprType::AllTagsExactMatch:	EmitTags(EOp::AllTags, true, false, Expr.TagSet, Index); return;
+	default: break;
+	}
+
+	FInstruction Node;
+	switch (Expr.ExprType)
+	{
+	case EGameplayTagQueryExprType::AnyExprMatch:	Node.Op = EOp::AnyExpr; break;
+	case EGameplayTagQueryExprType::AllExprMatch:	Node.Op = EOp::AllExpr; break;
+	case EGameplayTagQueryExprType::NoExprMatch:	Node.Op = EOp::AnyExpr; Node.bNegate = true; break;
+	default:
+		// Undefined expressions never match, as in FGameplayTagQuery::Matches.
+		Code.Add({ EOp::Constant, false, false, 0 });
+		return;
+	}
+
+	// Postfix: the children leave their results on the stack, the node folds them.
+	for (const FGameplayTagQueryExpression& Child : Expr.ExprSet)
+	{
+		Emit(Child, Index);
+	}
+	Node.Arg = Expr.ExprSet.Num();
+	Code.Add(Node);
+}
+
+void FKzDatabaseTagProgram::EmitTags(EOp Op, bool bExact, bool bNegate, const TArray<FGameplayTag>& Tags, const FKzDatabaseTagIndex& Index)
+{
+	const int32 MaskOffset = Masks.AddZeroed(NumWords);
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (const int32* Bit = Index.TagBits.Find(Tag))
+		{
+			Masks[MaskOffset + (*Bit >> 6)] |= uint64(1) << (*Bit & 63);
+		}
+		else if (Op == EOp::AllTags)
+		{
+			// No item carries the tag, so no item has them all.
+			Masks.SetNum(MaskOffset, EAllowShrinking::No);
+			Code.Add({ EOp::Constant, bExact, bNegate, 0 });
+			return;
+		}
+	}
+
+	// Tags without a bit are simply absent from the mask: no item carries them.
+	Code.Add({ Op, bExact, bNegate, MaskOffset });
+}
+
+uint64 FKzDatabaseTagProgram::MatchesBatch(const FKzDatabaseTagIndex& Index, TConstArrayView<int32> ItemIndices) const
+{
+	check(ItemIndices.Num() <= 64 && Revision == Index.Revision);
+
+	const int32 NumLanes = ItemIndices.Num();
+	const uint64 AllLanes = NumLanes == 64 ? ~uint64(0) : (uint64(1) << NumLanes) - 1;
+
+	if (Code.IsEmpty())
+	{
+		return AllLanes;
+	}
+
+	// One bit per item: leaves fill a lane word, nodes combine lane words with plain AND / OR.
+	TArray<uint64, TInlineAllocator<16>> Stack;
+	for (const FInstruction& Instruction : Code)
+	{
+		uint64 Lanes = 0;
+		switch (Instruction.Op)
+		{
+		case EOp::Constant:
+			Lanes = Instruction.Arg ? AllLanes : 0;
+			break;
+
+		case EOp::AnyTags:
+		case EOp::AllTags:
+		{
+			const uint64* Mask = Masks.GetData() + Instruction.Arg;
+			const bool bAll = Instruction.Op == EOp::AllTags;
+			for (int32 Lane = 0; Lane < NumLanes; ++Lane)
+			{
+				const uint64* Bits = Instruction.bExact ? Index.GetExactBits(ItemIndices[Lane]) : Index.GetItemBits(ItemIndices[Lane]);
+
+				uint64 Hit = 0;
+				uint64 Missing = 0;
+				for (int32 Word = 0; Word < NumWords; ++Word)
+				{
+					Hit |= Bits[Word] & Mask[Word];
+					Missing |= ~Bits[Word] & Mask[Word];
+				}
+				Lanes |= uint64(bAll ? Missing == 0 : Hit != 0) << Lane;
+			}
+			break;
+		}
+
+		case EOp::AnyExpr:
+		case EOp::AllExpr:
+		{
+			const bool bAll = Instruction.Op == EOp::AllExpr;
+			Lanes = bAll ? AllLanes : 0;
+			for (int32 Child = 0; Child < Instruction.Arg; ++Child)
+			{
+				const uint64 Value = Stack.Pop(EAllowShrinking::No);
+				Lanes = bAll ? Lanes & Value : Lanes | Value;
+			}
+			break;
+		}
+		}
+
+		Stack.Add(Instruction.bNegate ? Lanes ^ AllLanes : Lanes);
+	}
+
+	check(Stack.Num() == 1);
+	return Stack[0];
+}
+
+TSharedRef<const FKzDatabaseTagProgram> FKzDatabaseTagProgramCache::FindOrCompile(const FGameplayTagQuery& Query, const FKzDatabaseTagIndex& Index)
+{
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (Revision == Index.Revision)
+		{
+			if (const TSharedRef<const FKzDatabaseTagProgram>* Program = Programs.Find(Query))
+			{
+				return *Program;
+			}
+		}
+	}
+
+	// Compiled outside the lock; concurrent misses on the same query just compile it twice.
+	TSharedRef<FKzDatabaseTagProgram> Program = MakeShared<FKzDatabaseTagProgram>();
+	Program->Compile(Query, Index);
+
+	FWriteScopeLock WriteLock(Lock);
+	if (Revision != Index.Revision || Programs.Num() >= MaxPrograms)
+	{
+		Programs.Reset();
+		Revision = Index.Revision;
+	}
+	Programs.Add(Query, Program);
+	return Program;
+}
+
+void FKzDatabaseTagProgramCache::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Programs.Reset();
+}
+
+bool FKzDatabaseValueColumn::Allocate(const FKzTypeDef& Type, int32 NumItems)
+{
+	Reset();
+
+	ValueType = Type.ValueType;
+	TypeObject = Type.ValueTypeObject;
+	NumBuilt = NumItems;
+
+	if (NumItems == 0)
+	{
+		return false;
+	}
+
+	if (ValueType == EPropertyBagPropertyType::Struct)
+	{
+		const UScriptStruct* Struct = Cast<UScriptStruct>(TypeObject);
+		if (!Struct)
+		{
+			return false;
+		}
+
+		Stride = Struct->GetStructureSize();
+		Data = static_cast<uint8*>(FMemory::Malloc(SIZE_T(Stride) * NumItems, Struct->GetMinAlignment()));
+		Struct->InitializeStruct(Data, NumItems);
+		Num = NumItems;
+		return true;
+	}
+
+	return KzDatabase::DispatchColumnType(ValueType, [this, NumItems]<typename ColumnType>(KzDatabase::TColumnType<ColumnType>)
+	{
+		Stride = sizeof(ColumnType);
+		Data = static_cast<uint8*>(FMemory::Malloc(SIZE_T(Stride) * NumItems, alignof(ColumnType)));
+		DefaultConstructItems<ColumnType>(Data, NumItems);
+		Num = NumItems;
+	});
+}
+
+void FKzDatabaseValueColumn::Build(const FKzTypeDef& Type, const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision)
+{
+	const bool bAllocated = Allocate(Type, Items.Num());
+	ItemRevision = InItemRevision;
+	if (!bAllocated)
+	{
+		return;
+	}
+
+	// Items whose value does not hold the column type keep the default value.
+	if (ValueType == EPropertyBagPropertyType::Struct)
+	{
+		const UScriptStruct* Struct = CastChecked<UScriptStruct>(TypeObject);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const FKzVariant& Value = Items[Index].Value;
+			if (Value.GetType() == ValueType && Value.GetTypeObject() == Struct)
+			{
+				Struct->CopyScriptStruct(Data + Index * Stride, Value.GetData());
+			}
+		}
+		return;
+	}
+
+	KzDatabase::DispatchColumnType(ValueType, [this, &Items]<typename ColumnType>(KzDatabase::TColumnType<ColumnType>)
+	{
+		constexpr bool bRealColumn = std::is_same_v<ColumnType, float> || std::is_same_v<ColumnType, double>;
+
+		ColumnType* Elements = reinterpret_cast<ColumnType*>(Data);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const FKzVariant& Value = Items[Index].Value;
+			const EPropertyBagPropertyType ItemType = Value.GetType();
+
+			// FromProperty makes Double values for float pins, and either real type lives in the variant's double slot.
+			const bool bRealValue = ItemType == EPropertyBagPropertyType::Float || ItemType == EPropertyBagPropertyType::Double;
+			if (ItemType != ValueType && !(bRealColumn && bRealValue))
+			{
+				continue;
+			}
+
+			if constexpr (bRealColumn)
+			{
+				Elements[Index] = static_cast<ColumnType>(*static_cast<const double*>(Value.GetData()));
+			}
+			else
+			{
+				Elements[Index] = *static_cast<const ColumnType*>(Value.GetData());
+			}
+		}
+	});
+}
+
+template <typename VariantType>
+void FKzDatabaseValueColumn::CopyToVariant(int32 Index, VariantType& OutValue) const
+{
+	check(Index >= 0 && Index < Num);
+
+	OutValue.SetType(ValueType, TypeObject);
+
+	if (ValueType == EPropertyBagPropertyType::Struct)
+	{
+		CastChecked<UScriptStruct>(TypeObject)->CopyScriptStruct(OutValue.GetData(), Data + Index * Stride);
+		return;
+	}
+
+	KzDatabase::DispatchColumnType(ValueType, [this, Index, &OutValue]<typename ColumnType>(KzDatabase::TColumnType<ColumnType>)
+	{
+		if constexpr (std::is_same_v<ColumnType, float>)
+		{
+			*static_cast<double*>(OutValue.GetData()) = At<float>(Index);
+		}
+		else
+		{
+			*static_cast<ColumnType*>(OutValue.GetData()) = At<ColumnType>(Index);
+		}
+	});
+}
+
+void FKzDatabaseValueColumn::CopyTo(int32 Index, FKzVariant& OutValue) const
+{
+	CopyToVariant(Index, OutValue);
+}
+
+void FKzDatabaseValueColumn::CopyTo(int32 Index, FKzCompactVariant& OutValue) const
+{
+	CopyToVariant(Index, OutValue);
+}
+
+void FKzDatabaseValueColumn::Serialize(FArchive& Ar, const FKzTypeDef& Type, int32 NumItems, uint32 InItemRevision)
+{
+	if (Ar.IsLoading())
+	{
+		Allocate(Type, NumItems);
+		ItemRevision = InItemRevision;
+	}
+	check(Num == NumItems || Num == 0);
+
+	if (Num == 0)
+	{
+		return;
+	}
+
+	if (ValueType == EPropertyBagPropertyType::Struct)
+	{
+		UScriptStruct* Struct = const_cast<UScriptStruct*>(CastChecked<UScriptStruct>(TypeObject));
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Struct->SerializeItem(Ar, Data + Index * Stride, nullptr);
+		}
+		return;
+	}
+
+	KzDatabase::DispatchColumnType(ValueType, [this, &Ar]<typename ColumnType>(KzDatabase::TColumnType<ColumnType>)
+	{
+		if constexpr (TIsPODType<ColumnType>::Value)
+		{
+			// Plain numbers go through as one block.
+			Ar.Serialize(Data, int64(Stride) * Num);
+		}
+		else
+		{
+			ColumnType* Elements = reinterpret_cast<ColumnType*>(Data);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Ar << Elements[Index];
+			}
+		}
+	});
+}
+
+void FKzDatabaseValueColumn::Reset()
+{
+	if (Data)
+	{
+		if (ValueType == EPropertyBagPropertyType::Struct)
+		{
+			if (const UScriptStruct* Struct = Cast<UScriptStruct>(TypeObject))
+			{
+				Struct->DestroyStruct(Data, Num);
+			}
+		}
+		else
+		{
+			KzDatabase::DispatchColumnType(ValueType, [this]<typename ColumnType>(KzDatabase::TColumnType<ColumnType>)
+			{
+				DestructItems(reinterpret_cast<ColumnType*>(Data), Num);
+			});
+		}
+
+		FMemory::Free(Data);
+	}
+
+	ValueType = EPropertyBagPropertyType::None;
+	TypeObject = nullptr;
+	Data = nullptr;
+	Stride = 0;
+	Num = 0;
+	NumBuilt = INDEX_NONE;
+}
+
+FKzDatabaseCompiledQuery FKzDatabase::CompileQuery(const FKzDatabaseQuery& Query) const
+{
+	BuildTagIndex();
+
+	FKzDatabaseCompiledQuery Compiled;
+	Compiled.Revision = TagIndex.Revision;
+	Compiled.RequireMask.SetNumZeroed(TagIndex.NumWords);
+	Compiled.IgnoreMask.SetNumZeroed(TagIndex.NumWords);
+	Compiled.OptionalMask.SetNumZeroed(TagIndex.NumWords);
+
+	// Tags no item uses have no bit: a missing required tag fails every item, missing ignored or optional tags never hit.
+	for (const FGameplayTag& Tag : Query.RequireTags)
+	{
+		if (const int32* Bit = TagIndex.TagBits.Find(Tag))
+		{
+			KzDatabase::SetBit(Compiled.RequireMask, *Bit);
+		}
+		else
+		{
+			Compiled.bUnsatisfiable = true;
+		}
+	}
+
+	for (const FGameplayTag& Tag : Query.IgnoreTags)
+	{
+		if (const int32* Bit = TagIndex.TagBits.Find(Tag))
+		{
+			KzDatabase::SetBit(Compiled.IgnoreMask, *Bit);
+		}
+	}
+
+	for (const FGameplayTag& Tag : Query.OptionalTags)
+	{
+		if (const int32* Bit = TagIndex.TagBits.Find(Tag))
+		{
+			KzDatabase::SetBit(Compiled.OptionalMask, *Bit);
+		}
+	}
+
+	if (!Query.TagQuery.IsEmpty())
+	{
+		Compiled.TagProgram = TagPrograms.FindOrCompile(Query.TagQuery, TagIndex);
+	}
+
+	return Compiled;
+}
+
+void FKzDatabase::ForEachMatch(const FKzDatabaseQuery& Query, TFunctionRef<bool(const FKzDatabaseItem& Item, int32 Score)> Visitor) const
+{
+	if (Query.IsEmpty())
+	{
+		// Nothing to evaluate, every item matches with no score.
+		for (const FKzDatabaseItem& Item : Items)
+		{
+			if (!Visitor(Item, 0))
+			{
+				return;
+			}
+		}
+		return;
+	}
+
+	const FKzDatabaseCompiledQuery Compiled = CompileQuery(Query);
+	if (Compiled.bUnsatisfiable)
+	{
+		return;
+	}
+
+	// Survivors of the masks are buffered and run through the TagQuery program a lane block at a time.
+	TArray<int32, TInlineAllocator<64>> Block;
+	auto Flush = [this, &Compiled, &Visitor, &Block]()
+	{
+		bool bContinue = true;
+		for (uint64 Passed = Compiled.TagProgram->MatchesBatch(TagIndex, Block); Passed != 0 && bContinue; Passed &= Passed - 1)
+		{
+			const int32 Index = Block[FMath::CountTrailingZeros64(Passed)];
+			bContinue = Visitor(Items[Index], Compiled.CalculateScore(TagIndex.GetExactBits(Index)));
+		}
+		Block.Reset();
+		return bContinue;
+	};
+
+	auto Visit = [this, &Compiled, &Visitor, &Block, &Flush](int32 Index)
+	{
+		if (!Compiled.Matches(TagIndex.GetItemBits(Index)))
+		{
+			return true;
+		}
+
+		if (!Compiled.TagProgram)
+		{
+			return Visitor(Items[Index], Compiled.CalculateScore(TagIndex.GetExactBits(Index)));
+		}
+
+		Block.Add(Index);
+		return Block.Num() < 64 || Flush();
+	};
+
+	ON_SCOPE_EXIT
+	{
+		// Candidates left in a partial block after the walk below.
+		if (!Block.IsEmpty())
+		{
+			Flush();
+		}
+	};
+
+	if (Query.RequireTags.IsEmpty())
+	{
+		for (int32 Index = 0; Index < Items.Num(); ++Index)
+		{
+			if (!Visit(Index))
+			{
+				return;
+			}
+		}
+		return;
+	}
+
+	// Intersect the required posting lists, shortest first so the working set shrinks early.
+	TArray<const TArray<int32>*, TInlineAllocator<8>> Required;
+	for (const FGameplayTag& Tag : Query.RequireTags)
+	{
+		Required.Add(&TagIndex.Postings.FindChecked(Tag));
+	}
+
+	Required.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+
+	if (Required.Num() == 1)
+	{
+		// Walk the posting list in place.
+		for (const int32 Index : *Required[0])
+		{
+			if (!Visit(Index))
+			{
+				return;
+			}
+		}
+		return;
+	}
+
+	TArray<int32> Candidates = *Required[0];
+	for (int32 Index = 1; Index < Required.Num() && !Candidates.IsEmpty(); ++Index)
+	{
+		KzDatabase::IntersectSorted(Candidates, *Required[Index]);
+	}
+
+	for (const int32 Index : Candidates)
+	{
+		if (!Visit(Index))
+		{
+			return;
+		}
+	}
+}
+
+void FKzDatabase::RebuildIdIndex() const
+{
+	IdIndex.Reset();
+	IdIndex.Reserve(Items.Num());
+
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		// With duplicated IDs the first item wins, as with a linear search.
+		if (!IdIndex.Contains(Items[Index].ID))
+		{
+			IdIndex.Add(Items[Index].ID, Index);
+		}
+	}
+
+	NumIdIndexed = Items.Num();
+	IdIndexRevision = ItemRevision;
+}
+
+int32 FKzDatabase::FindItemIndex(FName ID) const
+{
+	if (!IsIdIndexUpToDate())
+	{
+		RebuildIdIndex();
+	}
+
+	const int32* Index = IdIndex.Find(ID);
+	if (Index && Items[*Index].ID != ID)
+	{
+		// An ID was edited in place without InvalidateIndex.
+		RebuildIdIndex();
+		Index = IdIndex.Find(ID);
+	}
+	return Index ? *Index : INDEX_NONE;
+}
+
 const FKzDatabaseItem* FKzDatabase::FindItem(FName ID) const
 {
-	return Items.FindByPredicate([&ID](const FKzDatabaseItem& Item) { return Item.ID == ID; });
+	const int32 Index = FindItemIndex(ID);
+	return Index != INDEX_NONE ? &Items[Index] : nullptr;
 }
 
 FKzDatabaseItem* FKzDatabase::FindItem(FName ID)
 {
-	return Items.FindByPredicate([&ID](const FKzDatabaseItem& Item) { return Item.ID == ID; });
+	const int32 Index = FindItemIndex(ID);
+	if (Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	// The caller may edit the item's tags or value through the returned pointer.
+	MarkItemsChanged();
+	return &Items[Index];
+}
+
+FKzDatabaseItem& FKzDatabase::FindOrAddItem(FName ID)
+{
+	int32 Index = FindItemIndex(ID);
+	if (Index == INDEX_NONE)
+	{
+		// FindItemIndex left the ID index up to date, extend it with the new item.
+		Index = Items.Num();
+		IdIndex.Add(ID, Index);
+		++NumIdIndexed;
+
+		Items.AddDefaulted_GetRef().ID = ID;
+	}
+
+	// The caller is about to edit the item, its tags may change.
+	MarkItemsChanged();
+	return Items[Index];
+}
+
+void FKzDatabase::RemoveItemAt(int32 Index)
+{
+	const FName RemovedID = Items[Index].ID;
+	if (IdIndex.FindChecked(RemovedID) == Index)
+	{
+		IdIndex.Remove(RemovedID);
+	}
+
+	Items.RemoveAt(Index, 1, EAllowShrinking::No);
+
+	for (int32 Shifted = Index; Shifted < Items.Num(); ++Shifted)
+	{
+		// Entries pointing at an earlier duplicate stay; a later duplicate of the removed ID takes over its entry.
+		int32& Entry = IdIndex.FindOrAdd(Items[Shifted].ID, Shifted);
+		if (Entry == Shifted + 1)
+		{
+			Entry = Shifted;
+		}
+	}
+
+	--NumIdIndexed;
+	MarkItemsChanged();
+}
+
+bool FKzDatabase::RemoveItem(FName ID)
+{
+	const int32 Index = FindItemIndex(ID);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveItemAt(Index);
+	return true;
+}
+
+int32 FKzDatabase::RemoveItems(TConstArrayView<FName> IDs)
+{
+	if (IDs.IsEmpty())
+	{
+		return 0;
+	}
+
+	TSet<FName> Removed;
+	Removed.Append(IDs);
+
+	// One stable compaction, then a single ID index rebuild, instead of shifting the tail per ID.
+	const int32 NumRemoved = Items.RemoveAll([&Removed](const FKzDatabaseItem& Item) { return Removed.Contains(Item.ID); });
+	if (NumRemoved > 0)
+	{
+		MarkItemsChanged(true);
+		RebuildIdIndex();
+	}
+	return NumRemoved;
+}
+
+int32 FKzDatabase::AddOrUpdateItems(TConstArrayView<FKzDatabaseItem> NewItems)
+{
+	Items.Reserve(Items.Num() + NewItems.Num());
+	IdIndex.Reserve(Items.Num() + NewItems.Num());
+
+	int32 NumApplied = 0;
+	for (const FKzDatabaseItem& NewItem : NewItems)
+	{
+		if (!NewItem.Value.MatchesType(Type))
+		{
+			continue;
+		}
+
+		FKzDatabaseItem& Item = FindOrAddItem(NewItem.ID);
+		Item.Tags = NewItem.Tags;
+		Item.Value = NewItem.Value;
+		++NumApplied;
+	}
+
+	ensureMsgf(NumApplied == NewItems.Num(), TEXT("FKzDatabase::AddOrUpdateItems: skipped %d items whose value does not match the database type."), NewItems.Num() - NumApplied);
+
+	MarkItemsChanged();
+	return NumApplied;
+}
+
+void FKzDatabase::PostSerialize(const FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		RebuildIdIndex();
+		MarkItemsChanged();
+	}
 }
 
 int32 FKzDatabase::QueryItems(const FKzDatabaseQuery& Query, TArray<const FKzDatabaseItem*>& OutItems) const
@@ -71,14 +958,11 @@ int32 FKzDatabase::QueryItems(const FKzDatabaseQuery& Query, TArray<const FKzDat
 	};
 	TArray<FScoredItem> ScoredResults;
 
-	for (const FKzDatabaseItem& Item : Items)
+	ForEachMatch(Query, [&ScoredResults](const FKzDatabaseItem& Item, int32 Score)
 	{
-		if (Query.Matches(Item.Tags))
-		{
-			int32 Score = Query.CalculateScore(Item.Tags);
-			ScoredResults.Add({ &Item, Score });
-		}
-	}
+		ScoredResults.Add({ &Item, Score });
+		return true;
+	});
 
 	if (!Query.OptionalTags.IsEmpty())
 	{
@@ -94,25 +978,243 @@ int32 FKzDatabase::QueryItems(const FKzDatabaseQuery& Query, TArray<const FKzDat
 	return OutItems.Num();
 }
 
+int32 FKzDatabase::QueryTopK(const FKzDatabaseQuery& Query, int32 K, TArray<const FKzDatabaseItem*>& OutItems) const
+{
+	OutItems.Reset();
+
+	TArray<KzDatabase::FRankedItem> Ranked;
+	KzDatabase::CollectTopK(*this, Query, K, Ranked);
+
+	OutItems.Reserve(Ranked.Num());
+	for (const KzDatabase::FRankedItem& Entry : Ranked)
+	{
+		OutItems.Add(&Items[Entry.Index]);
+	}
+
+	return OutItems.Num();
+}
+
+const FKzDatabaseItem* FKzDatabase::PickWeightedRandom(const FKzDatabaseQuery& Query, int32 K, const FRandomStream& Stream, TFunctionRef<float(const FKzDatabaseItem& Item, int32 Score)> Weight) const
+{
+	const FKzDatabaseItem* Picked = nullptr;
+	float TotalWeight = 0.0f;
+
+	// Single-slot weighted reservoir: each candidate replaces the pick with probability Weight / TotalWeight so far.
+	auto Offer = [&Picked, &TotalWeight, &Stream](const FKzDatabaseItem& Item, float ItemWeight)
+	{
+		if (ItemWeight > 0.0f)
+		{
+			TotalWeight += ItemWeight;
+			if (Stream.FRand() * TotalWeight < ItemWeight)
+			{
+				Picked = &Item;
+			}
+		}
+	};
+
+	if (K <= 0)
+	{
+		ForEachMatch(Query, [&Offer, &Weight](const FKzDatabaseItem& Item, int32 Score)
+		{
+			Offer(Item, Weight(Item, Score));
+			return true;
+		});
+		return Picked;
+	}
+
+	TArray<KzDatabase::FRankedItem> Ranked;
+	KzDatabase::CollectTopK(*this, Query, K, Ranked);
+
+	for (const KzDatabase::FRankedItem& Entry : Ranked)
+	{
+		Offer(Items[Entry.Index], Weight(Items[Entry.Index], Entry.Score));
+	}
+	return Picked;
+}
+
+const FKzDatabaseItem* FKzDatabase::PickWeightedRandom(const FKzDatabaseQuery& Query, int32 K, const FRandomStream& Stream) const
+{
+	return PickWeightedRandom(Query, K, Stream, [](const FKzDatabaseItem&, int32 Score) { return float(Score + 1); });
+}
+
 const FKzDatabaseItem* FKzDatabase::FindBestMatch(const FKzDatabaseQuery& Query) const
 {
 	const FKzDatabaseItem* BestItem = nullptr;
 	int32 BestScore = -1;
 
-	for (const FKzDatabaseItem& Item : Items)
+	// Matches are visited in item order, so the first of equal scores wins.
+	ForEachMatch(Query, [&BestItem, &BestScore](const FKzDatabaseItem& Item, int32 Score)
 	{
-		if (Query.Matches(Item.Tags))
+		if (Score > BestScore)
 		{
-			const int32 Score = Query.CalculateScore(Item.Tags);
+			BestScore = Score;
+			BestItem = &Item;
+		}
+		return true;
+	});
+
+	return BestItem;
+}
 
-			// If we found a strictly better score, update the winner
-			if (Score > BestScore)
+void FKzDatabase::QueryBatch(TConstArrayView<FKzDatabaseQuery> Queries, TArrayView<const FKzDatabaseItem*> OutBest) const
+{
+	check(Queries.Num() == OutBest.Num());
+
+	for (const FKzDatabaseItem*& Best : OutBest)
+	{
+		Best = nullptr;
+	}
+
+	if (Queries.IsEmpty() || Items.IsEmpty())
+	{
+		return;
+	}
+
+	// Compiling builds the index up front, the passes below only read it.
+	TArray<FKzDatabaseCompiledQuery> Compiled;
+	Compiled.Reserve(Queries.Num());
+	for (const FKzDatabaseQuery& Query : Queries)
+	{
+		Compiled.Add(CompileQuery(Query));
+	}
+
+	// Items are split in fixed chunks, each keeping the best match per query. Chunks are merged in
+	// item order with strict comparisons, so the first of equal scores wins as in FindBestMatch.
+	constexpr int32 ChunkSize = 1024;
+	constexpr int32 MinParallelWork = 32 * 1024;
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Items.Num(), ChunkSize);
+	const bool bSingleThread = int64(Items.Num()) * Queries.Num() < MinParallelWork;
+
+	TArray<KzDatabase::FRankedItem> ChunkBest;
+	ChunkBest.Init({ INDEX_NONE, -1 }, NumChunks * Queries.Num());
+
+	ParallelFor(NumChunks, [this, &Queries, &Compiled, &ChunkBest](int32 Chunk)
+	{
+		KzDatabase::FRankedItem* Best = ChunkBest.GetData() + Chunk * Queries.Num();
+
+		const int32 End = FMath::Min(Items.Num(), (Chunk + 1) * ChunkSize);
+		for (int32 Index = Chunk * ChunkSize; Index < End; ++Index)
+		{
+			// Every query is evaluated against the item while its bitsets are in cache.
+			const uint64* ItemBits = TagIndex.GetItemBits(Index);
+			const uint64* ExactBits = TagIndex.GetExactBits(Index);
+
+			for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+			{
+				const FKzDatabaseCompiledQuery& Query = Compiled[QueryIndex];
+				if (Query.bUnsatisfiable || !Query.Matches(ItemBits))
+				{
+					continue;
+				}
+
+				const int32 Score = Query.CalculateScore(ExactBits);
+				if (Score > Best[QueryIndex].Score && (!Query.TagProgram || Query.TagProgram->Matches(TagIndex, Index)))
+				{
+					Best[QueryIndex] = { Index, Score };
+				}
+			}
+		}
+	}, bSingleThread);
+
+	for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+	{
+		KzDatabase::FRankedItem Best{ INDEX_NONE, -1 };
+		for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+		{
+			const KzDatabase::FRankedItem& Candidate = ChunkBest[Chunk * Queries.Num() + QueryIndex];
+			if (Candidate.Score > Best.Score)
 			{
-				BestScore = Score;
-				BestItem = &Item;
+				Best = Candidate;
 			}
 		}
+
+		if (Best.Index != INDEX_NONE)
+		{
+			OutBest[QueryIndex] = &Items[Best.Index];
+		}
 	}
+}
 
-	return BestItem;
-}
\ No newline at end of file
+namespace KzDatabase
+{
+	/** Header of FKzDatabase::SerializePacked. */
+	struct FPackedHeader
+	{
+		static constexpr uint32 ExpectedMagic = 0x42445A4B; // "KZDB"
+		static constexpr uint32 LatestVersion = 1;
+
+		uint32 Magic = ExpectedMagic;
+		uint32 Version = LatestVersion;
+		int32 NumItems = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FPackedHeader& Header)
+		{
+			return Ar << Header.Magic << Header.Version << Header.NumItems;
+		}
+	};
+}
+
+void FKzDatabase::SerializePacked(FArchive& Ar)
+{
+	KzDatabase::FPackedHeader Header;
+
+	if (Ar.IsSaving())
+	{
+		BuildIndex();
+		Header.NumItems = Items.Num();
+	}
+
+	Ar << Header;
+	if (!ensureMsgf(Header.Magic == KzDatabase::FPackedHeader::ExpectedMagic && Header.Version <= KzDatabase::FPackedHeader::LatestVersion, TEXT("FKzDatabase: unknown packed item data.")))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	TArray<FName> IDs;
+	if (Ar.IsSaving())
+	{
+		IDs.Reserve(Items.Num());
+		for (const FKzDatabaseItem& Item : Items)
+		{
+			IDs.Add(Item.ID);
+		}
+	}
+	Ar << IDs;
+
+	TagIndex.Serialize(Ar, Header.NumItems, ItemRevision);
+	ValueColumn.Serialize(Ar, Type, Header.NumItems, ItemRevision);
+
+	if (Ar.IsLoading())
+	{
+		// Rebuild the items from the columns; the indices are already up to date.
+		Items.SetNum(Header.NumItems);
+		for (int32 Index = 0; Index < Header.NumItems; ++Index)
+		{
+			FKzDatabaseItem& Item = Items[Index];
+			Item.ID = IDs[Index];
+
+			Item.Tags.Reset();
+			const uint64* Bits = TagIndex.GetExactBits(Index);
+			for (int32 Word = 0; Word < TagIndex.NumWords; ++Word)
+			{
+				for (uint64 Remaining = Bits[Word]; Remaining != 0; Remaining &= Remaining - 1)
+				{
+					Item.Tags.AddTag(TagIndex.BitTags[Word * 64 + int32(FMath::CountTrailingZeros64(Remaining))]);
+				}
+			}
+
+			if (Index < ValueColumn.GetNum())
+			{
+				ValueColumn.CopyTo(Index, Item.Value);
+			}
+			else
+			{
+				Item.SyncType(Type);
+			}
+		}
+
+		RebuildIdIndex();
+	}
+}
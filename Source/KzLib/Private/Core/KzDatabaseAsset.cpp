@@ -1,19 +1,273 @@
 // Copyright 2026 kirzo
 
 #include "Core/KzDatabaseAsset.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/ObjectSaveContext.h"
+#include <atomic>
 
 #if WITH_EDITOR
 #include "Misc/MessageDialog.h"
 #endif
 
-const FKzDatabaseItem* UKzDatabaseAsset::ResolveMatch(const FKzDatabaseQuery& Query) const
+void UKzDatabaseAsset::Serialize(FArchive& Ar)
+{
+	// Cooked data stores the item tables in FKzDatabase's packed format rather than as tagged properties:
+	// the items are held back from the tagged pass and written (or read) right after it.
+	const bool bPackedItems = Ar.IsPersistent() && Ar.IsFilterEditorOnly() && !Ar.IsObjectReferenceCollector();
+	if (!bPackedItems)
+	{
+		Super::Serialize(Ar);
+		return;
+	}
+
+	TArray<FKzDatabaseItem> Items;
+	TArray<FKzDatabaseItem> FlattenedItems;
+	if (Ar.IsSaving())
+	{
+		Items = MoveTemp(Database.Items);
+		FlattenedItems = MoveTemp(FlattenedDatabase.Items);
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsSaving())
+	{
+		Database.Items = MoveTemp(Items);
+		FlattenedDatabase.Items = MoveTemp(FlattenedItems);
+	}
+
+	Database.SerializePacked(Ar);
+	FlattenedDatabase.SerializePacked(Ar);
+}
+
+void UKzDatabaseAsset::PostLoad()
 {
+	Super::PostLoad();
+
+	// Compile the item tag bitsets up front so the first query does not pay for it.
+	Database.BuildIndex();
+
+	if (bFlattened)
+	{
+		// Cooked chains are loaded as a whole and only change if modified at runtime.
+		RecordFlattenedState();
+		FlattenedDatabase.BuildIndex();
+	}
+}
+
+void UKzDatabaseAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	if (SaveContext.IsCooking())
+	{
+		Flatten();
+	}
+	else if (bFlattened)
+	{
+		// Source assets never store a merged table, it would go stale as soon as a parent is edited.
+		FlattenedDatabase.Empty();
+		bFlattened = false;
+	}
+}
+
+void UKzDatabaseAsset::Flatten()
+{
+	FlattenedDatabase.Type = Database.Type;
+	FlattenedDatabase.Empty();
+
+	// Chain order is precedence order: FindBestMatch keeps the first of equal scores, so local items beat parents on ties.
+	int32 NumItems = 0;
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		NumItems += Asset->Database.Items.Num();
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+
+	FlattenedDatabase.Items.Reserve(NumItems);
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		FlattenedDatabase.Items.Append(Asset->Database.Items);
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+
+	FlattenedDatabase.InvalidateIndex();
+	FlattenedDatabase.BuildIndex();
+
+	bFlattened = true;
+	RecordFlattenedState();
+}
+
+void UKzDatabaseAsset::RecordFlattenedState()
+{
+	FlattenedVersion = GetChainVersion();
+	FlattenedItemRevisions.Reset();
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		FlattenedItemRevisions.Add(Asset->Database.GetItemRevision());
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+}
+
+bool UKzDatabaseAsset::IsFlattenedUpToDate() const
+{
+	if (!bFlattened || FlattenedVersion != GetChainVersion())
+	{
+		return false;
+	}
+
+	// Edits through the FKzDatabase mutators only bump the item revision of the edited database.
+	int32 NumChecked = 0;
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		if (!FlattenedItemRevisions.IsValidIndex(NumChecked) || FlattenedItemRevisions[NumChecked] != Asset->Database.GetItemRevision())
+		{
+			return false;
+		}
+		++NumChecked;
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+	return NumChecked == FlattenedItemRevisions.Num();
+}
+
+namespace KzDatabaseAsset
+{
+	/** Source of asset versions. Monotonic, so a change anywhere in a chain raises the chain's maximum. */
+	static std::atomic<uint32> GVersionCounter{ 0 };
+}
+
+uint32 UKzDatabaseAsset::GetChainVersion() const
+{
+	uint32 ChainVersion = Version;
+	for (const UKzDatabaseAsset* Parent = ParentDatabase; Parent && Parent != this; Parent = Parent->ParentDatabase)
+	{
+		ChainVersion = FMath::Max(ChainVersion, Parent->Version);
+	}
+	return ChainVersion;
+}
+
+void UKzDatabaseAsset::NotifyDatabaseChanged()
+{
+	Version = ++KzDatabaseAsset::GVersionCounter;
+}
+
+uint32 UKzDatabaseAsset::GetQueryCacheStamp() const
+{
+	// Edits through the FKzDatabase mutators bump the database's item revision, not the asset version.
+	uint32 Stamp = GetChainVersion();
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		Stamp = HashCombineFast(Stamp, HashCombineFast(Asset->Database.GetItemRevision(), Asset->FlattenedDatabase.GetItemRevision()));
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+	return Stamp;
+}
+
+FKzDatabaseQueryCacheEntry UKzDatabaseAsset::ResolveMatchEntry(const FKzDatabaseQuery& Query) const
+{
+	const uint32 Stamp = GetQueryCacheStamp();
+	{
+		FScopeLock Lock(&QueryCacheLock);
+		if (Stamp != QueryCacheStamp)
+		{
+			QueryCache.Empty(QueryCacheSize);
+			QueryCacheStamp = Stamp;
+		}
+
+		// A position past the end means Items were edited directly; resolve again.
+		const FKzDatabaseQueryCacheEntry* Cached = QueryCache.FindAndTouch(Query);
+		if (Cached && (!Cached->Database || Cached->Database->Items.IsValidIndex(Cached->ItemIndex)))
+		{
+			++QueryCacheStats.Hits;
+			return *Cached;
+		}
+		++QueryCacheStats.Misses;
+	}
+
+	// Resolved outside the lock; concurrent misses on the same query just resolve it twice.
 	int32 BestScore = -1;
-	return ResolveBestMatchRecursive(Query, BestScore);
+	FKzDatabaseQueryCacheEntry Entry;
+	if (const FKzDatabaseItem* BestItem = ResolveBestMatchRecursive(Query, BestScore))
+	{
+		Entry.Database = FindOwningDatabase(BestItem);
+		if (!ensureMsgf(Entry.Database, TEXT("UKzDatabaseAsset: resolved item is not held by any database of the chain.")))
+		{
+			return Entry;
+		}
+		Entry.ItemIndex = Entry.Database->GetItemIndex(BestItem);
+	}
+
+	FScopeLock Lock(&QueryCacheLock);
+	if (QueryCacheStamp == Stamp)
+	{
+		QueryCache.Add(Query, Entry);
+	}
+	return Entry;
+}
+
+const FKzDatabaseItem* UKzDatabaseAsset::ResolveMatch(const FKzDatabaseQuery& Query) const
+{
+	const FKzDatabaseQueryCacheEntry Match = ResolveMatchEntry(Query);
+	return Match.Database ? &Match.Database->Items[Match.ItemIndex] : nullptr;
+}
+
+FKzDatabaseQueryCacheStats UKzDatabaseAsset::GetQueryCacheStats() const
+{
+	FScopeLock Lock(&QueryCacheLock);
+	return QueryCacheStats;
+}
+
+void UKzDatabaseAsset::ResetQueryCacheStats() const
+{
+	FScopeLock Lock(&QueryCacheLock);
+	QueryCacheStats = FKzDatabaseQueryCacheStats();
+}
+
+const FKzDatabase* UKzDatabaseAsset::FindOwningDatabase(const FKzDatabaseItem* Item) const
+{
+	for (const UKzDatabaseAsset* Asset = this; Asset; Asset = Asset->ParentDatabase)
+	{
+		if (Asset->FlattenedDatabase.GetItemIndex(Item) != INDEX_NONE)
+		{
+			return &Asset->FlattenedDatabase;
+		}
+		if (Asset->Database.GetItemIndex(Item) != INDEX_NONE)
+		{
+			return &Asset->Database;
+		}
+		if (Asset->ParentDatabase == this)
+		{
+			break;
+		}
+	}
+	return nullptr;
 }
 
 const FKzDatabaseItem* UKzDatabaseAsset::ResolveBestMatchRecursive(const FKzDatabaseQuery& Query, int32& OutBestScore) const
 {
+	// 0. A merged table of the whole chain answers in a single indexed query
+	if (IsFlattenedUpToDate())
+	{
+		const FKzDatabaseItem* BestItem = FlattenedDatabase.FindBestMatch(Query);
+		OutBestScore = BestItem ? Query.CalculateScore(BestItem->Tags) : -1;
+		return BestItem;
+	}
+
 	// 1. Find the best match locally in this Asset
 	const FKzDatabaseItem* LocalBestItem = Database.FindBestMatch(Query);
 	int32 LocalScore = -1;
@@ -49,6 +303,10 @@ void UKzDatabaseAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyCha
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	// Any edit (including undo) may have touched item tags or the parent chain.
+	Database.InvalidateIndex();
+	NotifyDatabaseChanged();
+
 	const FName PropertyName = (PropertyChangedEvent.Property != nullptr) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 
 	// Validate changes to the Parent Database
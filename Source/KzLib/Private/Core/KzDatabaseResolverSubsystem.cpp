@@ -0,0 +1,160 @@
+// Copyright 2026 kirzo
+
+#include "Core/KzDatabaseResolverSubsystem.h"
+#include "Components/KzDatabaseComponent.h"
+#include "GameFramework/Actor.h"
+
+namespace KzDatabaseResolver
+{
+	/** Collects the assets of a component that can take part in resolution. */
+	static void GatherAssets(const UKzDatabaseComponent& Component, TArray<TObjectPtr<UKzDatabaseAsset>>& OutAssets)
+	{
+		for (UKzDatabaseAsset* Asset : Component.Databases)
+		{
+			if (Asset && Asset->Database.Type.IsValid())
+			{
+				OutAssets.Add(Asset);
+			}
+		}
+	}
+
+	static uint32 HashAssets(const TArray<TObjectPtr<UKzDatabaseAsset>>& Assets)
+	{
+		uint32 Hash = GetTypeHash(Assets.Num());
+		for (const TObjectPtr<UKzDatabaseAsset>& Asset : Assets)
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Asset.Get()));
+		}
+		return Hash;
+	}
+}
+
+void UKzDatabaseResolverSubsystem::Deinitialize()
+{
+	Contexts.Empty();
+	ContextsByHash.Empty();
+	ComponentContexts.Empty();
+	ActorContexts.Empty();
+
+	Super::Deinitialize();
+}
+
+void UKzDatabaseResolverSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// The dispatch tables only hold assets that are also in Assets.
+	for (TUniquePtr<FKzDatabaseContext>& Context : CastChecked<UKzDatabaseResolverSubsystem>(InThis)->Contexts)
+	{
+		Collector.AddReferencedObjects(Context->Assets);
+	}
+}
+
+const FKzDatabaseContext* UKzDatabaseResolverSubsystem::RegisterComponent(UKzDatabaseComponent* Component)
+{
+	if (!ensureMsgf(Component, TEXT("UKzDatabaseResolverSubsystem: cannot register a null component.")))
+	{
+		return nullptr;
+	}
+
+	TArray<TObjectPtr<UKzDatabaseAsset>> Assets;
+	KzDatabaseResolver::GatherAssets(*Component, Assets);
+	const uint32 Hash = KzDatabaseResolver::HashAssets(Assets);
+
+	int32 ContextId = INDEX_NONE;
+	for (auto It = ContextsByHash.CreateConstKeyIterator(Hash); It; ++It)
+	{
+		if (Contexts[It.Value()]->Assets == Assets)
+		{
+			ContextId = It.Value();
+			break;
+		}
+	}
+
+	if (ContextId == INDEX_NONE)
+	{
+		TUniquePtr<FKzDatabaseContext> Context = MakeUnique<FKzDatabaseContext>();
+		Context->Hash = Hash;
+
+		// Later assets win when several resolve the same type, as the component used to do.
+		for (UKzDatabaseAsset* Asset : Assets)
+		{
+			const int32 TypeId = Asset->GetDataType().GetTypeId();
+			if (TypeId >= Context->DispatchTable.Num())
+			{
+				Context->DispatchTable.SetNum(TypeId + 1);
+			}
+			Context->DispatchTable[TypeId] = Asset;
+		}
+		Context->Assets = MoveTemp(Assets);
+
+		ContextId = Contexts.Add(MoveTemp(Context));
+		ContextsByHash.Add(Hash, ContextId);
+	}
+
+	// Register before releasing the previous context so re-registering the same set never destroys it.
+	FKzDatabaseContext& Context = *Contexts[ContextId];
+	++Context.NumUsers;
+
+	const TObjectKey<UKzDatabaseComponent> ComponentKey(Component);
+	if (const int32* PreviousId = ComponentContexts.Find(ComponentKey))
+	{
+		ReleaseContext(*PreviousId);
+	}
+	ComponentContexts.Add(ComponentKey, ContextId);
+
+	if (const AActor* Owner = Component->GetOwner())
+	{
+		ActorContexts.Add(Owner, ContextId);
+	}
+
+	return &Context;
+}
+
+void UKzDatabaseResolverSubsystem::UnregisterComponent(UKzDatabaseComponent* Component)
+{
+	int32 ContextId = INDEX_NONE;
+	if (!ComponentContexts.RemoveAndCopyValue(Component, ContextId))
+	{
+		return;
+	}
+
+	if (const AActor* Owner = Component->GetOwner())
+	{
+		const TObjectKey<AActor> OwnerKey(Owner);
+		if (const int32* ActorContextId = ActorContexts.Find(OwnerKey); ActorContextId && *ActorContextId == ContextId)
+		{
+			ActorContexts.Remove(OwnerKey);
+		}
+	}
+
+	ReleaseContext(ContextId);
+}
+
+void UKzDatabaseResolverSubsystem::ReleaseContext(int32 ContextId)
+{
+	FKzDatabaseContext& Context = *Contexts[ContextId];
+	if (--Context.NumUsers > 0)
+	{
+		return;
+	}
+
+	ContextsByHash.RemoveSingle(Context.Hash, ContextId);
+	Contexts.RemoveAt(ContextId);
+}
+
+const FKzDatabaseContext* UKzDatabaseResolverSubsystem::FindContext(const AActor* Actor) const
+{
+	const int32* ContextId = ActorContexts.Find(Actor);
+	return ContextId ? Contexts[*ContextId].Get() : nullptr;
+}
+
+void UKzDatabaseResolverSubsystem::GroupByContext(TConstArrayView<const AActor*> Actors, TArray<int32>& OutContextIds) const
+{
+	OutContextIds.Reset(Actors.Num());
+	for (const AActor* Actor : Actors)
+	{
+		const int32* ContextId = Actor ? ActorContexts.Find(Actor) : nullptr;
+		OutContextIds.Add(ContextId ? *ContextId : INDEX_NONE);
+	}
+}
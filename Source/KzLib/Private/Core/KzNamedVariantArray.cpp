@@ -0,0 +1,85 @@
+// Copyright 2026 kirzo
+
+#include "Core/KzNamedVariantArray.h"
+
+bool FKzNamedVariantArrayItem::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << Name;
+	return Value.NetSerializePacked(Ar, Map, bOutSuccess, Quantization);
+}
+
+int32 FKzNamedVariantArray::FindIndex(FName Name) const
+{
+	return Items.IndexOfByPredicate([Name](const FKzNamedVariantArrayItem& Item) { return Item.Name == Name; });
+}
+
+void FKzNamedVariantArray::SetValue(FName Name, const FKzVariant& Value, const FKzNetQuantization& Quantization)
+{
+	const int32 Index = FindIndex(Name);
+	if (Index == INDEX_NONE)
+	{
+		FKzNamedVariantArrayItem& Item = Items.AddDefaulted_GetRef();
+		Item.Name = Name;
+		Item.Value = Value;
+		Item.Quantization = Quantization;
+		MarkItemDirty(Item);
+		return;
+	}
+
+	FKzNamedVariantArrayItem& Item = Items[Index];
+	Item.Quantization = Quantization;
+	if (Item.Value != Value)
+	{
+		Item.Value = Value;
+		MarkItemDirty(Item);
+	}
+}
+
+bool FKzNamedVariantArray::RemoveValue(FName Name)
+{
+	const int32 Index = FindIndex(Name);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Entries are identified by replication ID, so the order can change freely.
+	Items.RemoveAtSwap(Index, EAllowShrinking::No);
+	MarkArrayDirty();
+	return true;
+}
+
+const FKzVariant* FKzNamedVariantArray::FindValue(FName Name) const
+{
+	const int32 Index = FindIndex(Name);
+	return Index != INDEX_NONE ? &Items[Index].Value : nullptr;
+}
+
+void FKzNamedVariantArray::Assign(TConstArrayView<FKzNamedVariant> Variants, TConstArrayView<FKzParamDef> Defs)
+{
+	for (const FKzNamedVariant& Variant : Variants)
+	{
+		const FKzParamDef* Def = Defs.FindByPredicate([&Variant](const FKzParamDef& Candidate) { return Candidate.Name == Variant.GetName(); });
+		SetValue(Variant.GetName(), Variant.GetValue(), Def ? Def->NetQuantization : FKzNetQuantization());
+	}
+
+	const int32 NumItems = Items.Num();
+	Items.RemoveAllSwap([Variants](const FKzNamedVariantArrayItem& Item)
+	{
+		return !Variants.ContainsByPredicate([&Item](const FKzNamedVariant& Variant) { return Variant.GetName() == Item.Name; });
+	}, EAllowShrinking::No);
+
+	if (Items.Num() != NumItems)
+	{
+		MarkArrayDirty();
+	}
+}
+
+void FKzNamedVariantArray::ToNamedVariants(TArray<FKzNamedVariant>& OutVariants) const
+{
+	OutVariants.Reset(Items.Num());
+	for (const FKzNamedVariantArrayItem& Item : Items)
+	{
+		OutVariants.Emplace(Item.Name, Item.Value);
+	}
+}
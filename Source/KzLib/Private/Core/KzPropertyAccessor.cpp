@@ -0,0 +1,397 @@
+// Copyright 2026 kirzo
+
+#include "Core/KzPropertyAccessor.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace KzPropertyAccessor
+{
+	struct FKey
+	{
+		const FProperty* Property;
+
+		/** Guards against a property freed with its class and another one allocated at the same address. */
+		TObjectKey<UStruct> Owner;
+
+		FKzTypeDef TypeDef;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Property == Other.Property && Owner == Other.Owner && TypeDef == Other.TypeDef;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombineFast(HashCombineFast(GetTypeHash(Key.Property), GetTypeHash(Key.Owner)), GetTypeHash(Key.TypeDef));
+		}
+	};
+
+	struct FAccessorRegistry
+	{
+		FRWLock Lock;
+		/** Incompatible pairs are cached too, as nullptr. */
+		TMap<FKey, TUniquePtr<FKzPropertyAccessor>> Accessors;
+
+#if WITH_EDITOR
+		/** Accessors dropped on reinstancing, kept alive so pointers handed out earlier never dangle. */
+		TArray<TUniquePtr<FKzPropertyAccessor>> Retired;
+
+		FAccessorRegistry()
+		{
+			// Recompiled blueprints and user structs get new properties at new offsets, possibly at the old
+			// addresses and under the same owner, so no cached key can be trusted afterwards.
+			FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([this](const FCoreUObjectDelegates::FReplacementObjectMap&)
+			{
+				FWriteScopeLock WriteLock(Lock);
+				for (TPair<FKey, TUniquePtr<FKzPropertyAccessor>>& Pair : Accessors)
+				{
+					if (Pair.Value.IsValid())
+					{
+						Retired.Add(MoveTemp(Pair.Value));
+					}
+				}
+				Accessors.Reset();
+			});
+		}
+#endif
+	};
+
+	static FAccessorRegistry& GetAccessorRegistry()
+	{
+		static FAccessorRegistry Registry;
+		return Registry;
+	}
+
+	/** Plain load/store between property memory of type TValue and the variant slot of type TSlot. */
+	template <typename TValue, typename TSlot = TValue>
+	static void ReadValue(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest)
+	{
+		if constexpr (std::is_same_v<TValue, TSlot>)
+		{
+			*static_cast<TSlot*>(Dest) = *static_cast<const TValue*>(ValuePtr);
+		}
+		else
+		{
+			*static_cast<TSlot*>(Dest) = static_cast<TSlot>(*static_cast<const TValue*>(ValuePtr));
+		}
+	}
+
+	template <typename TValue, typename TSlot = TValue>
+	static void WriteValue(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr)
+	{
+		if constexpr (std::is_same_v<TValue, TSlot>)
+		{
+			*static_cast<TValue*>(ValuePtr) = *static_cast<const TSlot*>(Src);
+		}
+		else
+		{
+			*static_cast<TValue*>(ValuePtr) = static_cast<TValue>(*static_cast<const TSlot*>(Src));
+		}
+	}
+
+	// Bools may be bitfields, so they go through the property's mask.
+	static void ReadBool(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest)
+	{
+		*static_cast<bool*>(Dest) = static_cast<const FBoolProperty*>(Accessor.GetProperty())->GetPropertyValue(ValuePtr);
+	}
+
+	static void WriteBool(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr)
+	{
+		static_cast<const FBoolProperty*>(Accessor.GetProperty())->SetPropertyValue(ValuePtr, *static_cast<const bool*>(Src));
+	}
+
+	static void ReadStruct(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest)
+	{
+		static_cast<const FStructProperty*>(Accessor.GetProperty())->Struct->CopyScriptStruct(Dest, ValuePtr);
+	}
+
+	static void WriteStruct(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr)
+	{
+		static_cast<const FStructProperty*>(Accessor.GetProperty())->Struct->CopyScriptStruct(ValuePtr, Src);
+	}
+
+	static void ReadClass(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest)
+	{
+		*static_cast<TObjectPtr<UClass>*>(Dest) = Cast<UClass>(static_cast<const TObjectPtr<UObject>*>(ValuePtr)->Get());
+	}
+
+	static void WriteClass(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr)
+	{
+		*static_cast<TObjectPtr<UObject>*>(ValuePtr) = static_cast<const TObjectPtr<UClass>*>(Src)->Get();
+	}
+
+	/** Soft object and soft class properties both store an FSoftObjectPtr; TSoftPtr is the variant slot type. */
+	template <typename TSoftPtr>
+	static void ReadSoft(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest)
+	{
+		*static_cast<TSoftPtr*>(Dest) = TSoftPtr(static_cast<const FSoftObjectPtr*>(ValuePtr)->ToSoftObjectPath());
+	}
+
+	template <typename TSoftPtr>
+	static void WriteSoft(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr)
+	{
+		*static_cast<FSoftObjectPtr*>(ValuePtr) = FSoftObjectPtr(static_cast<const TSoftPtr*>(Src)->ToSoftObjectPath());
+	}
+
+	/** Picks the load/store pair of an enum from the width and signedness of its underlying property. Enum values are held as int64. */
+	static bool GetEnumFuncs(const FNumericProperty* Underlying, FKzPropertyAccessor::FReadFunc& OutRead, FKzPropertyAccessor::FWriteFunc& OutWrite)
+	{
+		if (Underlying->IsA<FByteProperty>())		{ OutRead = &ReadValue<uint8, int64>;		OutWrite = &WriteValue<uint8, int64>;		return true; }
+		if (Underlying->IsA<FInt8Property>())		{ OutRead = &ReadValue<int8, int64>;		OutWrite = &WriteValue<int8, int64>;		return true; }
+		if (Underlying->IsA<FUInt16Property>())	{ OutRead = &ReadValue<uint16, int64>;	OutWrite = &WriteValue<uint16, int64>;	return true; }
+		if (Underlying->IsA<FInt16Property>())	{ OutRead = &ReadValue<int16, int64>;		OutWrite = &WriteValue<int16, int64>;		return true; }
+		if (Underlying->IsA<FUInt32Property>())	{ OutRead = &ReadValue<uint32, int64>;	OutWrite = &WriteValue<uint32, int64>;	return true; }
+		if (Underlying->IsA<FIntProperty>())		{ OutRead = &ReadValue<int32, int64>;		OutWrite = &WriteValue<int32, int64>;		return true; }
+		if (Underlying->IsA<FUInt64Property>())	{ OutRead = &ReadValue<uint64, int64>;	OutWrite = &WriteValue<uint64, int64>;	return true; }
+		if (Underlying->IsA<FInt64Property>())	{ OutRead = &ReadValue<int64>;					OutWrite = &WriteValue<int64>;					return true; }
+		return false;
+	}
+
+	static bool IsReal(EPropertyBagPropertyType Type)
+	{
+		return Type == EPropertyBagPropertyType::Float || Type == EPropertyBagPropertyType::Double;
+	}
+}
+
+const FKzPropertyAccessor* FKzPropertyAccessor::Get(const FProperty* Property, const FKzTypeDef& TypeDef)
+{
+	if (!Property)
+	{
+		return nullptr;
+	}
+
+	KzPropertyAccessor::FAccessorRegistry& Registry = KzPropertyAccessor::GetAccessorRegistry();
+	const KzPropertyAccessor::FKey Key{ Property, Property->GetOwnerStruct(), TypeDef };
+
+	{
+		FReadScopeLock ReadLock(Registry.Lock);
+		if (const TUniquePtr<FKzPropertyAccessor>* Accessor = Registry.Accessors.Find(Key))
+		{
+			return Accessor->Get();
+		}
+	}
+
+	FWriteScopeLock WriteLock(Registry.Lock);
+	if (const TUniquePtr<FKzPropertyAccessor>* Accessor = Registry.Accessors.Find(Key))
+	{
+		return Accessor->Get();
+	}
+	return Registry.Accessors.Add(Key, Create(Property, TypeDef)).Get();
+}
+
+void FKzPropertyAccessor::GetForParams(const UStruct* Struct, TConstArrayView<FKzParamDef> Params, TArray<const FKzPropertyAccessor*>& OutAccessors)
+{
+	OutAccessors.Reset(Params.Num());
+	for (const FKzParamDef& Param : Params)
+	{
+		const FProperty* Property = Struct ? FindFProperty<FProperty>(Struct, Param.Name) : nullptr;
+		OutAccessors.Add(Get(Property, Param.Type));
+	}
+}
+
+TUniquePtr<FKzPropertyAccessor> FKzPropertyAccessor::Create(const FProperty* Property, const FKzTypeDef& TypeDef)
+{
+	// Variants only hold single values: no containers, no static arrays.
+	if (TypeDef.ContainerType != EPropertyBagContainerType::None || Property->GetArrayDim() != 1 || !TypeDef.MatchesProperty(Property))
+	{
+		return nullptr;
+	}
+
+	using namespace KzPropertyAccessor;
+
+	TUniquePtr<FKzPropertyAccessor> Accessor = MakeUnique<FKzPropertyAccessor>();
+	Accessor->Property = Property;
+	Accessor->TypeDef = TypeDef;
+	Accessor->Offset = Property->GetOffset_ForInternal();
+
+	switch (TypeDef.ValueType)
+	{
+		case EPropertyBagPropertyType::Bool:
+			Accessor->ReadFunc = &ReadBool;
+			Accessor->WriteFunc = &WriteBool;
+			break;
+		case EPropertyBagPropertyType::Byte:
+			Accessor->ReadFunc = &ReadValue<uint8>;
+			Accessor->WriteFunc = &WriteValue<uint8>;
+			break;
+		case EPropertyBagPropertyType::Int32:
+			Accessor->ReadFunc = &ReadValue<int32>;
+			Accessor->WriteFunc = &WriteValue<int32>;
+			break;
+		case EPropertyBagPropertyType::Int64:
+			Accessor->ReadFunc = &ReadValue<int64>;
+			Accessor->WriteFunc = &WriteValue<int64>;
+			break;
+		case EPropertyBagPropertyType::Float:
+		case EPropertyBagPropertyType::Double:
+			// Variants hold both as double; the property decides the width.
+			if (Property->IsA<FFloatProperty>())
+			{
+				Accessor->ReadFunc = &ReadValue<float, double>;
+				Accessor->WriteFunc = &WriteValue<float, double>;
+			}
+			else
+			{
+				Accessor->ReadFunc = &ReadValue<double>;
+				Accessor->WriteFunc = &WriteValue<double>;
+			}
+			break;
+		case EPropertyBagPropertyType::Name:
+			Accessor->ReadFunc = &ReadValue<FName>;
+			Accessor->WriteFunc = &WriteValue<FName>;
+			break;
+		case EPropertyBagPropertyType::String:
+			Accessor->ReadFunc = &ReadValue<FString>;
+			Accessor->WriteFunc = &WriteValue<FString>;
+			break;
+		case EPropertyBagPropertyType::Text:
+			Accessor->ReadFunc = &ReadValue<FText>;
+			Accessor->WriteFunc = &WriteValue<FText>;
+			break;
+		case EPropertyBagPropertyType::Enum:
+		{
+			const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property);
+			const FNumericProperty* Underlying = EnumProperty ? EnumProperty->GetUnderlyingProperty() : CastField<FByteProperty>(Property);
+			if (!Underlying || !GetEnumFuncs(Underlying, Accessor->ReadFunc, Accessor->WriteFunc))
+			{
+				return nullptr;
+			}
+			Accessor->TypeObject = EnumProperty ? EnumProperty->GetEnum() : CastField<FByteProperty>(Property)->Enum.Get();
+			break;
+		}
+		case EPropertyBagPropertyType::Struct:
+			Accessor->ReadFunc = &ReadStruct;
+			Accessor->WriteFunc = &WriteStruct;
+			Accessor->TypeObject = CastField<FStructProperty>(Property)->Struct;
+			break;
+		case EPropertyBagPropertyType::Object:
+			Accessor->ReadFunc = &ReadValue<TObjectPtr<UObject>>;
+			Accessor->WriteFunc = &WriteValue<TObjectPtr<UObject>>;
+			Accessor->CheckClass = CastField<FObjectProperty>(Property)->PropertyClass;
+			break;
+		case EPropertyBagPropertyType::Class:
+			Accessor->ReadFunc = &ReadClass;
+			Accessor->WriteFunc = &WriteClass;
+			Accessor->CheckClass = CastField<FClassProperty>(Property)->MetaClass;
+			break;
+		case EPropertyBagPropertyType::SoftObject:
+			Accessor->ReadFunc = &ReadSoft<TSoftObjectPtr<UObject>>;
+			Accessor->WriteFunc = &WriteSoft<TSoftObjectPtr<UObject>>;
+			Accessor->TypeObject = CastField<FSoftObjectProperty>(Property)->PropertyClass;
+			Accessor->CheckClass = CastField<FSoftObjectProperty>(Property)->PropertyClass;
+			break;
+		case EPropertyBagPropertyType::SoftClass:
+			Accessor->ReadFunc = &ReadSoft<TSoftClassPtr<UObject>>;
+			Accessor->WriteFunc = &WriteSoft<TSoftClassPtr<UObject>>;
+			Accessor->TypeObject = CastField<FSoftClassProperty>(Property)->MetaClass;
+			Accessor->CheckClass = CastField<FSoftClassProperty>(Property)->MetaClass;
+			break;
+		default:
+			return nullptr;
+	}
+
+	// Object and Class variants take their type object from the value, the others from the property.
+	Accessor->bFixedTypeObject = Accessor->TypeObject != nullptr;
+
+	// The same rules as FKzVariant::MatchesProperty, against the type objects resolved above.
+	switch (TypeDef.ValueType)
+	{
+		case EPropertyBagPropertyType::Enum:
+		case EPropertyBagPropertyType::Struct:
+			Accessor->TypeObjectCheck = ETypeObjectCheck::Exact;
+			break;
+		case EPropertyBagPropertyType::Object:
+		case EPropertyBagPropertyType::Class:
+			Accessor->TypeObjectCheck = ETypeObjectCheck::ValueDerived;
+			break;
+		case EPropertyBagPropertyType::SoftObject:
+		case EPropertyBagPropertyType::SoftClass:
+			Accessor->TypeObjectCheck = ETypeObjectCheck::PropertyDerived;
+			break;
+		default:
+			break;
+	}
+
+	return Accessor;
+}
+
+void FKzPropertyAccessor::Read(const void* Container, FKzVariant& Value) const
+{
+	// SetType resets every slot, so it is skipped when the variant already holds this type.
+	if (Value.GetType() != TypeDef.ValueType || (bFixedTypeObject && Value.GetTypeObject() != TypeObject))
+	{
+		Value.SetType(TypeDef.ValueType, TypeObject);
+	}
+
+	ReadFunc(*this, static_cast<const uint8*>(Container) + Offset, Value.GetData());
+}
+
+bool FKzPropertyAccessor::Write(const FKzVariant& Value, void* Container) const
+{
+	const EPropertyBagPropertyType ValueType = Value.GetType();
+	if (ValueType != TypeDef.ValueType && !(KzPropertyAccessor::IsReal(ValueType) && KzPropertyAccessor::IsReal(TypeDef.ValueType)))
+	{
+		return false;
+	}
+
+	if (TypeObjectCheck != ETypeObjectCheck::None)
+	{
+		const UObject* HeldTypeObject = Value.GetTypeObject();
+		switch (TypeObjectCheck)
+		{
+			case ETypeObjectCheck::Exact:
+				if (HeldTypeObject != TypeObject)
+				{
+					return false;
+				}
+				break;
+			case ETypeObjectCheck::ValueDerived:
+				// Class-typed variants report a UClass; null values fit any property.
+				if (HeldTypeObject && !(CheckClass && static_cast<const UClass*>(HeldTypeObject)->IsChildOf(CheckClass)))
+				{
+					return false;
+				}
+				break;
+			case ETypeObjectCheck::PropertyDerived:
+				if (HeldTypeObject && !(CheckClass && CheckClass->IsChildOf(static_cast<const UClass*>(HeldTypeObject))))
+				{
+					return false;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	WriteFunc(*this, Value.GetData(), static_cast<uint8*>(Container) + Offset);
+	return true;
+}
+
+void FKzPropertyAccessor::ReadAll(TConstArrayView<const FKzPropertyAccessor*> Accessors, const void* Container, TArrayView<FKzVariant> OutValues)
+{
+	checkf(Accessors.Num() == OutValues.Num(), TEXT("FKzPropertyAccessor::ReadAll: %d accessors for %d values"), Accessors.Num(), OutValues.Num());
+
+	for (int32 Index = 0; Index < Accessors.Num(); ++Index)
+	{
+		if (const FKzPropertyAccessor* Accessor = Accessors[Index])
+		{
+			Accessor->Read(Container, OutValues[Index]);
+		}
+	}
+}
+
+int32 FKzPropertyAccessor::WriteAll(TConstArrayView<const FKzPropertyAccessor*> Accessors, TConstArrayView<FKzVariant> Values, void* Container)
+{
+	checkf(Accessors.Num() == Values.Num(), TEXT("FKzPropertyAccessor::WriteAll: %d accessors for %d values"), Accessors.Num(), Values.Num());
+
+	int32 NumWritten = 0;
+	for (int32 Index = 0; Index < Accessors.Num(); ++Index)
+	{
+		if (const FKzPropertyAccessor* Accessor = Accessors[Index])
+		{
+			NumWritten += Accessor->Write(Values[Index], Container) ? 1 : 0;
+		}
+	}
+	return NumWritten;
+}
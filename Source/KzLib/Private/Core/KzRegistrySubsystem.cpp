@@ -0,0 +1,280 @@
+// Copyright 2026 kirzo
+
+#include "Core/KzRegistrySubsystem.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+
+bool FKzObjectBucket::Add(UObject* Object)
+{
+	const FObjectKey Key(Object);
+	if (Indices.Contains(Key))
+	{
+		return false;
+	}
+
+	Indices.Add(Key, Objects.Add(Object));
+	Keys.Add(Key);
+	return true;
+}
+
+bool FKzObjectBucket::Remove(UObject* Object)
+{
+	const int32* Index = Indices.Find(FObjectKey(Object));
+	if (!Index)
+	{
+		return false;
+	}
+
+	RemoveAtSwap(*Index);
+	return true;
+}
+
+void FKzObjectBucket::Sweep(TFunctionRef<void(const FObjectKey&)> OnRemoved, int32 Budget)
+{
+	for (int32 Inspected = 0; Inspected < Budget && !Objects.IsEmpty(); ++Inspected)
+	{
+		if (SweepCursor >= Objects.Num())
+		{
+			SweepCursor = 0;
+		}
+
+		if (Objects[SweepCursor].IsStale())
+		{
+			// The last entry moves into the cursor slot and gets inspected next.
+			OnRemoved(Keys[SweepCursor]);
+			RemoveAtSwap(SweepCursor);
+		}
+		else
+		{
+			++SweepCursor;
+		}
+	}
+}
+
+void FKzObjectBucket::RemoveAtSwap(int32 Index)
+{
+	Indices.Remove(Keys[Index]);
+
+	const int32 LastIndex = Objects.Num() - 1;
+	if (Index != LastIndex)
+	{
+		Objects[Index] = Objects[LastIndex];
+		Keys[Index] = Keys[LastIndex];
+		Indices.FindChecked(Keys[Index]) = Index;
+	}
+	Objects.Pop(EAllowShrinking::No);
+	Keys.Pop(EAllowShrinking::No);
+}
+
+FKzObjectBucket* UKzRegistrySubsystem::FindBucket(const UClass* Class) const
+{
+	const TUniquePtr<FKzObjectBucket>* Bucket = RegistryMap.Find(Class);
+	return Bucket ? Bucket->Get() : nullptr;
+}
+
+FKzObjectBucket& UKzRegistrySubsystem::FindOrAddBucket(UClass* Class)
+{
+	TUniquePtr<FKzObjectBucket>& Bucket = RegistryMap.FindOrAdd(Class);
+	if (!Bucket.IsValid())
+	{
+		Bucket = MakeUnique<FKzObjectBucket>();
+
+		// A new bucket becomes visible to subclass-inclusive queries on the class and every ancestor.
+		for (const UClass* Ancestor = Class; Ancestor; Ancestor = Ancestor->GetSuperClass())
+		{
+			HierarchyIndex.FindOrAdd(Ancestor).Add(Bucket.Get());
+		}
+	}
+	return *Bucket;
+}
+
+void UKzRegistrySubsystem::SweepBucket(const UClass* Class, FKzObjectBucket& Bucket)
+{
+	if (SpatialBuckets.Contains(Class))
+	{
+		Bucket.Sweep([this, Class](const FObjectKey& Key) { RemoveSpatialItem(Class, Key); });
+	}
+	else
+	{
+		Bucket.Sweep([](const FObjectKey&) {});
+	}
+}
+
+void UKzRegistrySubsystem::GatherBuckets(const UClass* Class, bool bIncludeSubclasses, TArray<const FKzObjectBucket*, TInlineAllocator<8>>& OutBuckets) const
+{
+	if (bIncludeSubclasses)
+	{
+		if (const TArray<FKzObjectBucket*, TInlineAllocator<4>>* Buckets = HierarchyIndex.Find(Class))
+		{
+			OutBuckets.Append(*Buckets);
+		}
+	}
+	else if (const FKzObjectBucket* Bucket = FindBucket(Class))
+	{
+		OutBuckets.Add(Bucket);
+	}
+}
+
+namespace KzRegistry
+{
+	/** Bounds and mobility of an actor or scene component. Returns false for other objects. */
+	static bool GetSpatialPlacement(const UObject* Object, FBox& OutBounds, bool& bOutDynamic)
+	{
+		const USceneComponent* Component = Cast<USceneComponent>(Object);
+		if (const AActor* Actor = Cast<AActor>(Object))
+		{
+			Component = Actor->GetRootComponent();
+			if (!Component)
+			{
+				// Actors without a root still have a location; index them as a point.
+				OutBounds = FBox(Actor->GetActorLocation(), Actor->GetActorLocation());
+				bOutDynamic = true;
+				return true;
+			}
+		}
+
+		if (!Component)
+		{
+			return false;
+		}
+
+		OutBounds = Component->Bounds.GetBox();
+		bOutDynamic = Component->Mobility == EComponentMobility::Movable;
+		return true;
+	}
+}
+
+void UKzRegistrySubsystem::Deinitialize()
+{
+	SpatialBuckets.Reset();
+
+	Super::Deinitialize();
+}
+
+void UKzRegistrySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Buckets nobody registers into anymore still get their destroyed entries dropped.
+	// Items destroyed without being unregistered leave their spatial index here too.
+	for (TPair<const UClass*, TUniquePtr<FKzObjectBucket>>& Pair : RegistryMap)
+	{
+		SweepBucket(Pair.Key, *Pair.Value);
+	}
+
+	for (TPair<const UClass*, TUniquePtr<FKzSpatialBucket>>& Pair : SpatialBuckets)
+	{
+		FKzSpatialBucket& Spatial = *Pair.Value;
+
+		for (FKzSpatialItem* Item : Spatial.DynamicItems)
+		{
+			// Destroyed items keep their last bounds until the sweep drops them.
+			if (const UObject* Object = Item->Object.Get())
+			{
+				bool bDynamic;
+				KzRegistry::GetSpatialPlacement(Object, Item->Bounds, bDynamic);
+			}
+		}
+
+		// Re-indexes only the dynamic items whose refreshed bounds moved past the threshold.
+		Spatial.Index.TickDynamics();
+	}
+}
+
+TStatId UKzRegistrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UKzRegistrySubsystem, STATGROUP_Tickables);
+}
+
+void UKzRegistrySubsystem::EnableSpatialIndex(UClass* Class, float CellSize)
+{
+	if (!ensureMsgf(Class && (Class->IsChildOf<AActor>() || Class->IsChildOf<USceneComponent>()), TEXT("UKzRegistrySubsystem: spatial indexing needs an actor or scene component class.")))
+	{
+		return;
+	}
+
+	TUniquePtr<FKzSpatialBucket>& Spatial = SpatialBuckets.FindOrAdd(Class);
+	if (Spatial.IsValid())
+	{
+		return;
+	}
+
+	Spatial = MakeUnique<FKzSpatialBucket>();
+	Spatial->Index.SetCellSize(CellSize);
+
+	if (const FKzObjectBucket* Bucket = FindBucket(Class))
+	{
+		Bucket->ForEachLive([this, Class](UObject* Object) { AddSpatialItem(Class, Object); });
+	}
+}
+
+void UKzRegistrySubsystem::AddSpatialItem(const UClass* Class, UObject* Object)
+{
+	TUniquePtr<FKzSpatialBucket>* Spatial = SpatialBuckets.Find(Class);
+	if (!Spatial)
+	{
+		return;
+	}
+
+	FKzSpatialItem Placement;
+	Placement.Object = Object;
+	if (!KzRegistry::GetSpatialPlacement(Object, Placement.Bounds, Placement.bDynamic))
+	{
+		return;
+	}
+
+	TUniquePtr<FKzSpatialItem>& Item = (*Spatial)->Items.FindOrAdd(FObjectKey(Object));
+	if (!Item.IsValid())
+	{
+		Item = MakeUnique<FKzSpatialItem>(Placement);
+		if (Item->bDynamic)
+		{
+			Item->DynamicIndex = (*Spatial)->DynamicItems.Add(Item.Get());
+		}
+		(*Spatial)->Index.Register(Item.Get());
+	}
+}
+
+void UKzRegistrySubsystem::RemoveSpatialItem(const UClass* Class, const FObjectKey& Key)
+{
+	TUniquePtr<FKzSpatialBucket>* Spatial = SpatialBuckets.Find(Class);
+	if (!Spatial)
+	{
+		return;
+	}
+
+	TUniquePtr<FKzSpatialItem> Item;
+	if (!(*Spatial)->Items.RemoveAndCopyValue(Key, Item))
+	{
+		return;
+	}
+
+	if (Item->DynamicIndex != INDEX_NONE)
+	{
+		TArray<FKzSpatialItem*>& DynamicItems = (*Spatial)->DynamicItems;
+		DynamicItems.RemoveAtSwap(Item->DynamicIndex, EAllowShrinking::No);
+		if (DynamicItems.IsValidIndex(Item->DynamicIndex))
+		{
+			DynamicItems[Item->DynamicIndex]->DynamicIndex = Item->DynamicIndex;
+		}
+	}
+	(*Spatial)->Index.Unregister(Item.Get());
+}
+
+void UKzRegistrySubsystem::QueryObjectsInShape(const UClass* Class, TArray<TWeakObjectPtr<UObject>>& OutObjects, const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation) const
+{
+	const TUniquePtr<FKzSpatialBucket>* Spatial = SpatialBuckets.Find(Class);
+	if (ensureMsgf(Spatial, TEXT("UKzRegistrySubsystem: %s has no spatial index, call EnableSpatialIndex first."), *GetNameSafe(Class)))
+	{
+		(*Spatial)->Index.Query(OutObjects, Shape, Position, Rotation);
+	}
+}
+
+void UKzRegistrySubsystem::FindNearestObjects(const UClass* Class, TArray<TWeakObjectPtr<UObject>>& OutObjects, const FVector& Point, int32 K, float MaxDistance) const
+{
+	const TUniquePtr<FKzSpatialBucket>* Spatial = SpatialBuckets.Find(Class);
+	if (ensureMsgf(Spatial, TEXT("UKzRegistrySubsystem: %s has no spatial index, call EnableSpatialIndex first."), *GetNameSafe(Class)))
+	{
+		(*Spatial)->Index.FindNearest(OutObjects, Point, K, MaxDistance);
+	}
+}
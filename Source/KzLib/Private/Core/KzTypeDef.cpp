@@ -5,6 +5,50 @@
 
 const FKzTypeDef FKzTypeDef::Invalid = FKzTypeDef();
 
+namespace KzTypeDef
+{
+	struct FTypeIdRegistry
+	{
+		FRWLock Lock;
+		TMap<FKzTypeDef, int32> Ids;
+	};
+
+	static FTypeIdRegistry& GetTypeIdRegistry()
+	{
+		static FTypeIdRegistry Registry;
+		return Registry;
+	}
+}
+
+int32 FKzTypeDef::GetTypeId() const
+{
+	KzTypeDef::FTypeIdRegistry& Registry = KzTypeDef::GetTypeIdRegistry();
+
+	{
+		FReadScopeLock ReadLock(Registry.Lock);
+		if (const int32* TypeId = Registry.Ids.Find(*this))
+		{
+			return *TypeId;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Registry.Lock);
+	if (const int32* TypeId = Registry.Ids.Find(*this))
+	{
+		return *TypeId;
+	}
+	return Registry.Ids.Add(*this, Registry.Ids.Num());
+}
+
+int32 FKzTypeDef::FindTypeId() const
+{
+	KzTypeDef::FTypeIdRegistry& Registry = KzTypeDef::GetTypeIdRegistry();
+
+	FReadScopeLock ReadLock(Registry.Lock);
+	const int32* TypeId = Registry.Ids.Find(*this);
+	return TypeId ? *TypeId : INDEX_NONE;
+}
+
 bool FKzTypeDef::MatchesProperty(const FProperty* Property) const
 {
 	if (!Property) { return false; }
@@ -1,6 +1,7 @@
 // Copyright 2026 kirzo
 
 #include "Core/KzVariant.h"
+#include "Core/KzParamDef.h"
 #include "UObject/TextProperty.h"
 
 const FKzVariant FKzVariant::Invalid = FKzVariant();
@@ -324,32 +325,139 @@ bool FKzVariant::operator==(const FKzVariant& Other) const
 	}
 }
 
+namespace KzVariant
+{
+	/** Enough for every EPropertyBagPropertyType. */
+	constexpr uint32 NumTypeValues = 32;
+	static_assert(static_cast<uint32>(EPropertyBagPropertyType::Count) <= NumTypeValues);
+
+	/** Unsigned varint in 5-bit groups, each followed by a continuation bit: values below 32 take 6 bits. */
+	static void SerializeVarint(FArchive& Ar, uint64& Value)
+	{
+		if (Ar.IsLoading())
+		{
+			Value = 0;
+			for (int32 Shift = 0; Shift < 64 && !Ar.IsError(); Shift += 5)
+			{
+				uint8 Group = 0;
+				uint8 bMore = 0;
+				Ar.SerializeBits(&Group, 5);
+				Ar.SerializeBits(&bMore, 1);
+				Value |= uint64(Group) << Shift;
+				if (!bMore)
+				{
+					break;
+				}
+			}
+			return;
+		}
+
+		uint64 Remaining = Value;
+		do
+		{
+			uint8 Group = uint8(Remaining & 31);
+			Remaining >>= 5;
+			uint8 bMore = Remaining != 0;
+			Ar.SerializeBits(&Group, 5);
+			Ar.SerializeBits(&bMore, 1);
+		}
+		while (Remaining != 0);
+	}
+
+	/** Zig-zag maps small magnitudes of either sign to small unsigned values before the varint. */
+	static void SerializeSigned(FArchive& Ar, int64& Value)
+	{
+		uint64 Encoded = (uint64(Value) << 1) ^ uint64(Value >> 63);
+		SerializeVarint(Ar, Encoded);
+		if (Ar.IsLoading())
+		{
+			Value = int64(Encoded >> 1) ^ -int64(Encoded & 1);
+		}
+	}
+
+	static void SerializeSigned(FArchive& Ar, int32& Value)
+	{
+		int64 Wide = Value;
+		SerializeSigned(Ar, Wide);
+		Value = static_cast<int32>(Wide);
+	}
+
+	/** Quantisation mode in 2 bits, then the value at the precision it selects. */
+	static void SerializeReal(FArchive& Ar, double& Value, bool bSinglePrecision, const FKzNetQuantization& Quantization)
+	{
+		uint32 Mode = static_cast<uint32>(Quantization.Mode);
+		Ar.SerializeInt(Mode, 3);
+
+		if (static_cast<EKzNetQuantization>(Mode) == EKzNetQuantization::Fixed)
+		{
+			uint32 Decimals = FMath::Min<uint32>(Quantization.Decimals, 7);
+			Ar.SerializeInt(Decimals, 8);
+
+			const double Scale = FMath::Pow(10.0, double(Decimals));
+			int64 Units = Ar.IsLoading() ? 0 : int64(FMath::RoundToDouble(FMath::Clamp(Value * Scale, -9.0e18, 9.0e18)));
+			SerializeSigned(Ar, Units);
+			if (Ar.IsLoading())
+			{
+				Value = double(Units) / Scale;
+			}
+		}
+		else if (bSinglePrecision || static_cast<EKzNetQuantization>(Mode) == EKzNetQuantization::Float)
+		{
+			float Single = static_cast<float>(Value);
+			Ar << Single;
+			if (Ar.IsLoading())
+			{
+				// Saving must not narrow the sender's own value.
+				Value = Single;
+			}
+		}
+		else
+		{
+			Ar << Value;
+		}
+	}
+}
+
 bool FKzVariant::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	uint8 TypeByte = static_cast<uint8>(Type);
-	Ar << TypeByte;
+	return NetSerializePacked(Ar, Map, bOutSuccess, FKzNetQuantization());
+}
+
+bool FKzVariant::NetSerializePacked(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, const FKzNetQuantization& Quantization)
+{
+	uint32 TypeValue = static_cast<uint32>(Type);
+	Ar.SerializeInt(TypeValue, KzVariant::NumTypeValues);
 	if (Ar.IsLoading())
 	{
-		Type = static_cast<EPropertyBagPropertyType>(TypeByte);
+		Reset();
+		Type = static_cast<EPropertyBagPropertyType>(TypeValue);
 	}
 
+	bOutSuccess = true;
+
 	switch (Type)
 	{
 		case EPropertyBagPropertyType::None:		break;
-		case EPropertyBagPropertyType::Bool:		Ar << BoolValue;		break;
+		case EPropertyBagPropertyType::Bool:
+		{
+			uint8 Bit = BoolValue ? 1 : 0;
+			Ar.SerializeBits(&Bit, 1);
+			BoolValue = Bit != 0;
+			break;
+		}
 		case EPropertyBagPropertyType::Byte:		Ar << ByteValue; break;
 		case EPropertyBagPropertyType::Enum:
 		{
 			UEnum* Enum = EnumType.Get();
 			Ar << Enum;
 			if (Ar.IsLoading()) { EnumType = Enum; }
-			Ar << EnumValue;
+			KzVariant::SerializeSigned(Ar, EnumValue);
 			break;
 		}
-		case EPropertyBagPropertyType::Int32:		Ar << Int32Value;		break;
-		case EPropertyBagPropertyType::Int64:		Ar << Int64Value;		break;
-		case EPropertyBagPropertyType::Float:
-		case EPropertyBagPropertyType::Double:	Ar << DoubleValue;	break;
+		case EPropertyBagPropertyType::Int32:		KzVariant::SerializeSigned(Ar, Int32Value); break;
+		case EPropertyBagPropertyType::Int64:		KzVariant::SerializeSigned(Ar, Int64Value); break;
+		case EPropertyBagPropertyType::Float:		KzVariant::SerializeReal(Ar, DoubleValue, true, Quantization); break;
+		case EPropertyBagPropertyType::Double:	KzVariant::SerializeReal(Ar, DoubleValue, false, Quantization); break;
 		case EPropertyBagPropertyType::Name:		Ar << NameValue;		break;
 		case EPropertyBagPropertyType::String:	Ar << StringValue;	break;
 		case EPropertyBagPropertyType::Text:		Ar << TextValue;		break;
@@ -386,9 +494,9 @@ bool FKzVariant::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 		}
 		default:
 			ensureMsgf(false, TEXT("FKzVariant::NetSerialize: unhandled type %d"), (int32)Type);
+			bOutSuccess = false;
 			break;
 	}
 
-	bOutSuccess = true;
 	return true;
-}
\ No newline at end of file
+}
@@ -4,6 +4,9 @@
 #include "StructUtils/StructView.h"
 #include "Core/KzDatabaseAsset.h"
 #include "Components/KzDatabaseComponent.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+#include <atomic>
 
 // --- Standard Functions ---
 
@@ -31,6 +34,91 @@ static void GetWildcardProperty(FFrame& Stack, FProperty*& OutProp, void*& OutPt
 	OutPtr = Stack.MostRecentPropertyAddress;
 }
 
+/** Bumped when blueprints are reinstanced: their pin properties are recreated and addresses may be reused. */
+static std::atomic<uint32> GWildcardTypeIdGeneration{ 0 };
+
+namespace KzDatabaseLibrary
+{
+	/** A call site: the pin property and the struct owning it, whose serial number catches reused property addresses. */
+	struct FWildcardKey
+	{
+		const FProperty* Property = nullptr;
+		TObjectKey<UStruct> Owner;
+
+		bool operator==(const FWildcardKey& Other) const
+		{
+			return Property == Other.Property && Owner == Other.Owner;
+		}
+
+		friend uint32 GetTypeHash(const FWildcardKey& Key)
+		{
+			return HashCombineFast(GetTypeHash(Key.Property), GetTypeHash(Key.Owner));
+		}
+	};
+
+	struct FCachedTypeId
+	{
+		/** Value type object the ID was interned for; an entry whose type object is gone is worked out again. */
+		FObjectKey TypeObject;
+		bool bHasTypeObject = false;
+		int32 TypeId = INDEX_NONE;
+	};
+
+	/** Call sites cached per thread before the cache is flushed. */
+	static constexpr int32 MaxCachedTypeIds = 256;
+}
+
+/**
+ * Interned type ID of the database type matching a wildcard pin, or INDEX_NONE if no database of that type was ever registered.
+ * The ID is worked out once per call site (the pin property and its owner) and cached per thread, so repeated executions skip
+ * building the type definition and the type registry lookup.
+ */
+static int32 GetWildcardTypeId(const FProperty* Property)
+{
+	using namespace KzDatabaseLibrary;
+
+#if WITH_EDITOR
+	static const FDelegateHandle ReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const FCoreUObjectDelegates::FReplacementObjectMap&)
+	{
+		++GWildcardTypeIdGeneration;
+	});
+#endif
+
+	thread_local TMap<FWildcardKey, FCachedTypeId> Cache;
+	thread_local uint32 CacheGeneration = 0;
+
+	const uint32 Generation = GWildcardTypeIdGeneration.load(std::memory_order_relaxed);
+	if (Generation != CacheGeneration)
+	{
+		Cache.Reset();
+		CacheGeneration = Generation;
+	}
+
+	const FWildcardKey Key{ Property, Property->GetOwnerStruct() };
+	if (const FCachedTypeId* Cached = Cache.Find(Key))
+	{
+		if (!Cached->bHasTypeObject || Cached->TypeObject.ResolveObjectPtr())
+		{
+			return Cached->TypeId;
+		}
+	}
+
+	FPropertyBagPropertyDesc Desc(NAME_None, Property);
+	const FKzTypeDef SearchType(Desc.ContainerTypes.GetFirstContainerType(), Desc.ValueType, Desc.ValueTypeObject.Get());
+	const int32 TypeId = SearchType.FindTypeId();
+
+	// A type that is not interned yet may be once a database of that type registers, so misses are not cached.
+	if (TypeId != INDEX_NONE)
+	{
+		if (Cache.Num() >= MaxCachedTypeIds)
+		{
+			Cache.Reset();
+		}
+		Cache.Add(Key, { FObjectKey(SearchType.ValueTypeObject.Get()), SearchType.ValueTypeObject != nullptr, TypeId });
+	}
+	return TypeId;
+}
+
 static bool ArePropertiesCompatible(const FProperty* InputProp, const FProperty* TargetProp)
 {
 	// 1. Basic class check
@@ -97,16 +185,11 @@ DEFINE_FUNCTION(UKzDatabaseLibrary::execAddDatabaseItem)
 		// Validate compatibility against the database's declared type before touching the items array.
 		if (Database.Type.MatchesProperty(StackProp))
 		{
-			FKzDatabaseItem* Item = Database.FindItem(ID);
-			if (!Item)
-			{
-				Item = &Database.Items.AddDefaulted_GetRef();
-				Item->ID = ID;
-			}
+			FKzDatabaseItem& Item = Database.FindOrAddItem(ID);
 
-			Item->Tags = Tags;
-			Item->Value = FKzVariant::FromProperty(StackProp, StackPtr);
-			bSuccess = Item->Value.IsValid();
+			Item.Tags = Tags;
+			Item.Value = FKzVariant::FromProperty(StackProp, StackPtr);
+			bSuccess = Item.Value.IsValid();
 		}
 		else
 		{
@@ -141,6 +224,8 @@ DEFINE_FUNCTION(UKzDatabaseLibrary::execSetDatabaseItemValue)
 		{
 			Item->Value = FKzVariant::FromProperty(StackProp, StackPtr);
 			bSuccess = Item->Value.IsValid();
+
+			Database.InvalidateValues();
 		}
 		else
 		{
@@ -263,11 +348,7 @@ DEFINE_FUNCTION(UKzDatabaseLibrary::execResolveDatabaseQuery)
 
 	if (Component && OutValueProp && OutValuePtr)
 	{
-		// Build the search type from the wildcard pin's FProperty.
-		FPropertyBagPropertyDesc Desc(NAME_None, OutValueProp);
-		const FKzTypeDef SearchType(Desc.ContainerTypes.GetFirstContainerType(), Desc.ValueType, Desc.ValueTypeObject.Get());
-
-		if (UKzDatabaseAsset* Asset = Component->GetDatabaseAsset(SearchType))
+		if (UKzDatabaseAsset* Asset = Component->GetDatabaseAsset(GetWildcardTypeId(OutValueProp)))
 		{
 			if (const FKzDatabaseItem* BestItem = Asset->ResolveMatch(Query))
 			{
@@ -0,0 +1,214 @@
+// Copyright 2026 kirzo
+
+#include "Misc/AutomationTest.h"
+#include "Algo/StableSort.h"
+#include "Core/KzDatabase.h"
+#include "NativeGameplayTags.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace KzDatabaseTests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Color, "KzTest.Database.Color");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Color_Red, "KzTest.Database.Color.Red");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Color_Green, "KzTest.Database.Color.Green");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Color_Blue, "KzTest.Database.Color.Blue");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Size, "KzTest.Database.Size");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Size_Small, "KzTest.Database.Size.Small");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Size_Large, "KzTest.Database.Size.Large");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Hidden, "KzTest.Database.Hidden");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Rare, "KzTest.Database.Rare");
+
+	static constexpr int32 NumItems = 20000;
+	static constexpr int32 NumIterations = 20;
+
+	static FGameplayTagContainer MakeTags(std::initializer_list<FGameplayTag> Tags)
+	{
+		FGameplayTagContainer Container;
+		for (const FGameplayTag& Tag : Tags)
+		{
+			Container.AddTag(Tag);
+		}
+		return Container;
+	}
+
+	/** Deterministic items: one color and one size each (leaf tags, so parent tags only match through expansion), some hidden or rare. */
+	static void Generate(FKzDatabase& Database)
+	{
+		const FGameplayTag Colors[] = { TAG_Color_Red, TAG_Color_Green, TAG_Color_Blue };
+		const FGameplayTag Sizes[] = { TAG_Size_Small, TAG_Size_Large };
+
+		FRandomStream Stream(1234);
+		Database.Items.Reserve(NumItems);
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			FKzDatabaseItem& Item = Database.Items.AddDefaulted_GetRef();
+			Item.ID = FName(TEXT("Item"), i + 1);
+			Item.Tags.AddTag(Colors[Stream.RandHelper(UE_ARRAY_COUNT(Colors))]);
+			Item.Tags.AddTag(Sizes[Stream.RandHelper(UE_ARRAY_COUNT(Sizes))]);
+			if (Stream.FRand() < 0.2f)
+			{
+				Item.Tags.AddTag(TAG_Hidden);
+			}
+			if (Stream.FRand() < 0.1f)
+			{
+				Item.Tags.AddTag(TAG_Rare);
+			}
+		}
+		Database.InvalidateIndex();
+	}
+
+	static TArray<FKzDatabaseQuery> MakeQueries()
+	{
+		TArray<FKzDatabaseQuery> Queries;
+
+		// No constraints: every item, in item order.
+		Queries.AddDefaulted();
+
+		// Leaf requirement.
+		Queries.AddDefaulted_GetRef().RequireTags = MakeTags({ TAG_Color_Red });
+
+		// Parent requirement, met by every color through the tag hierarchy, with scoring.
+		{
+			FKzDatabaseQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.RequireTags = MakeTags({ TAG_Color });
+			Query.OptionalTags = MakeTags({ TAG_Size_Large, TAG_Rare });
+		}
+
+		// Exclusion only, with scoring.
+		{
+			FKzDatabaseQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.IgnoreTags = MakeTags({ TAG_Hidden });
+			Query.OptionalTags = MakeTags({ TAG_Color_Red, TAG_Size_Small, TAG_Rare });
+		}
+
+		// TagQuery: (Red or Blue) and not Hidden, on top of a parent requirement and an exclusion.
+		{
+			FKzDatabaseQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.RequireTags = MakeTags({ TAG_Size });
+			Query.IgnoreTags = MakeTags({ TAG_Rare });
+			Query.TagQuery = FGameplayTagQuery::BuildQuery(FGameplayTagQueryExpression()
+				.AllExprMatch()
+				.AddExpr(FGameplayTagQueryExpression().AnyTagsMatch().AddTag(TAG_Color_Red).AddTag(TAG_Color_Blue))
+				.AddExpr(FGameplayTagQueryExpression().NoTagsMatch().AddTag(TAG_Hidden)));
+		}
+
+		// TagQuery on a parent tag; optional parent tags only score on exact matches, so Color never scores here.
+		{
+			FKzDatabaseQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.TagQuery = FGameplayTagQuery::MakeQuery_MatchAnyTags(MakeTags({ TAG_Size }));
+			Query.OptionalTags = MakeTags({ TAG_Color, TAG_Size_Large });
+		}
+
+		// Nothing can match: every item has a size.
+		{
+			FKzDatabaseQuery& Query = Queries.AddDefaulted_GetRef();
+			Query.RequireTags = MakeTags({ TAG_Hidden, TAG_Color });
+			Query.IgnoreTags = MakeTags({ TAG_Size });
+		}
+
+		return Queries;
+	}
+
+	struct FScoredItem
+	{
+		const FKzDatabaseItem* Item;
+		int32 Score;
+	};
+
+	/** The unindexed reference: FKzDatabaseQuery::Matches and CalculateScore on every item, stable-sorted by score. */
+	static void QueryPerItem(const FKzDatabase& Database, const FKzDatabaseQuery& Query, TArray<FScoredItem>& OutItems)
+	{
+		OutItems.Reset();
+		for (const FKzDatabaseItem& Item : Database.Items)
+		{
+			if (Query.Matches(Item.Tags))
+			{
+				OutItems.Add({ &Item, Query.CalculateScore(Item.Tags) });
+			}
+		}
+		Algo::StableSortBy(OutItems, [](const FScoredItem& Entry) { return -Entry.Score; });
+	}
+
+	static double ElapsedMs(double StartSeconds)
+	{
+		return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKzDatabaseIndexedQueryTest, "KzLib.Database.IndexedQuery",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKzDatabaseIndexedQueryTest::RunTest(const FString& Parameters)
+{
+	using namespace KzDatabaseTests;
+
+	FKzDatabase Database;
+	Generate(Database);
+	Database.BuildIndex();
+
+	const TArray<FKzDatabaseQuery> Queries = MakeQueries();
+	for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); ++QueryIndex)
+	{
+		const FKzDatabaseQuery& Query = Queries[QueryIndex];
+
+		TArray<FScoredItem> Expected;
+		TArray<const FKzDatabaseItem*> Indexed;
+		const FKzDatabaseItem* BestItem = nullptr;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			QueryPerItem(Database, Query, Expected);
+		}
+		const double PerItemMs = ElapsedMs(Start) / NumIterations;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Database.QueryItems(Query, Indexed);
+		}
+		const double QueryItemsMs = ElapsedMs(Start) / NumIterations;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			BestItem = Database.FindBestMatch(Query);
+		}
+		const double FindBestMatchMs = ElapsedMs(Start) / NumIterations;
+
+		AddInfo(FString::Printf(TEXT("Query %d: %d matches, per item %.3f ms, QueryItems %.3f ms, FindBestMatch %.3f ms"),
+			QueryIndex, Expected.Num(), PerItemMs, QueryItemsMs, FindBestMatchMs));
+
+		if (!TestEqual(FString::Printf(TEXT("Query %d: match count"), QueryIndex), Indexed.Num(), Expected.Num()))
+		{
+			continue;
+		}
+
+		bool bSameItems = true;
+		bool bSameScores = true;
+		for (int32 i = 0; i < Expected.Num(); ++i)
+		{
+			bSameItems &= Indexed[i] == Expected[i].Item;
+			bSameScores &= Query.CalculateScore(Indexed[i]->Tags) == Expected[i].Score;
+		}
+		TestTrue(FString::Printf(TEXT("Query %d: QueryItems returns the same items in the same order"), QueryIndex), bSameItems);
+		TestTrue(FString::Printf(TEXT("Query %d: QueryItems returns the same scores"), QueryIndex), bSameScores);
+
+		const FKzDatabaseItem* ExpectedBest = Expected.IsEmpty() ? nullptr : Expected[0].Item;
+		TestTrue(FString::Printf(TEXT("Query %d: FindBestMatch returns the first best-scored item"), QueryIndex), BestItem == ExpectedBest);
+
+		// ForEachMatch hands out the scores computed on the bitsets.
+		bool bSameStreamedScores = true;
+		Database.ForEachMatch(Query, [&Query, &bSameStreamedScores](const FKzDatabaseItem& Item, int32 Score)
+		{
+			bSameStreamedScores &= Score == Query.CalculateScore(Item.Tags) && Query.Matches(Item.Tags);
+			return true;
+		});
+		TestTrue(FString::Printf(TEXT("Query %d: ForEachMatch scores match CalculateScore"), QueryIndex), bSameStreamedScores);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,242 @@
+// Copyright 2026 kirzo
+
+#include "Misc/AutomationTest.h"
+#include "Core/KzVariant.h"
+#include "Core/KzParamDef.h"
+#include "UObject/CoreNet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace KzVariantNetTests
+{
+	/**
+	 * FNetBitWriter without a package map: object references are written as indices into a shared table.
+	 * Both encodings reference objects the same way, so this does not bias the comparison.
+	 */
+	class FTestNetBitWriter : public FNetBitWriter
+	{
+	public:
+		explicit FTestNetBitWriter(TArray<UObject*>& InObjects)
+			: FNetBitWriter(8 * 1024)
+			, Objects(InObjects)
+		{
+		}
+
+		using FNetBitWriter::operator<<;
+
+		virtual FArchive& operator<<(UObject*& Object) override
+		{
+			uint32 Index = Objects.AddUnique(Object);
+			SerializeIntPacked(Index);
+			return *this;
+		}
+
+	private:
+		TArray<UObject*>& Objects;
+	};
+
+	class FTestNetBitReader : public FNetBitReader
+	{
+	public:
+		FTestNetBitReader(const TArray<UObject*>& InObjects, FTestNetBitWriter& Writer)
+			: FNetBitReader(nullptr, Writer.GetData(), Writer.GetNumBits())
+			, Objects(InObjects)
+		{
+		}
+
+		using FNetBitReader::operator<<;
+
+		virtual FArchive& operator<<(UObject*& Object) override
+		{
+			uint32 Index = 0;
+			SerializeIntPacked(Index);
+			Object = Objects.IsValidIndex(Index) ? Objects[Index] : nullptr;
+			return *this;
+		}
+
+	private:
+		const TArray<UObject*>& Objects;
+	};
+
+	/** The encoding FKzVariant::NetSerialize used before the packed format: a type byte and the value at full width. */
+	static void WriteLegacy(FArchive& Ar, const FKzVariant& Variant)
+	{
+		uint8 TypeByte = static_cast<uint8>(Variant.GetType());
+		Ar << TypeByte;
+
+		const void* Data = Variant.GetData();
+		switch (Variant.GetType())
+		{
+			case EPropertyBagPropertyType::Bool:
+			{
+				bool Value = *static_cast<const bool*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::Enum:
+			{
+				UObject* Enum = const_cast<UObject*>(Variant.GetTypeObject());
+				Ar << Enum;
+				int64 Value = *static_cast<const int64*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::Int32:
+			{
+				int32 Value = *static_cast<const int32*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::Int64:
+			{
+				int64 Value = *static_cast<const int64*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::Float:
+			case EPropertyBagPropertyType::Double:
+			{
+				double Value = *static_cast<const double*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::String:
+			{
+				FString Value = *static_cast<const FString*>(Data);
+				Ar << Value;
+				break;
+			}
+			case EPropertyBagPropertyType::Struct:
+			{
+				FInstancedStruct Value;
+				Value.InitializeAs(Cast<UScriptStruct>(Variant.GetTypeObject()), static_cast<const uint8*>(Data));
+				bool bSuccess = true;
+				Value.NetSerialize(Ar, nullptr, bSuccess);
+				break;
+			}
+			default:
+				checkNoEntry();
+				break;
+		}
+	}
+
+	static FKzNetQuantization MakeQuantization(EKzNetQuantization Mode, uint8 Decimals = 2)
+	{
+		FKzNetQuantization Quantization;
+		Quantization.Mode = Mode;
+		Quantization.Decimals = Decimals;
+		return Quantization;
+	}
+
+	struct FSample
+	{
+		const TCHAR* Name;
+		FKzVariant Value;
+		FKzNetQuantization Quantization;
+
+		/** Value expected after the round trip for quantised reals; unset when the value must come back unchanged. */
+		TOptional<double> ExpectedReal;
+
+		/**
+		 * Whether the packed encoding must be strictly smaller than the legacy one. Values near the type's range
+		 * (and full-precision doubles, which only save the type bits) may cost a few bits more as varints.
+		 */
+		bool bSmaller = true;
+	};
+
+	static TArray<FSample> MakeSamples()
+	{
+		const FKzNetQuantization None = MakeQuantization(EKzNetQuantization::None);
+		const FKzNetQuantization Float = MakeQuantization(EKzNetQuantization::Float);
+
+		const double Pi = 3.14159265358979;
+
+		return {
+			{ TEXT("Bool"), FKzVariant::Make<bool>(true), None },
+			{ TEXT("Int32 small"), FKzVariant::Make<int32>(5), None },
+			{ TEXT("Int32 small negative"), FKzVariant::Make<int32>(-3), None },
+			{ TEXT("Int32 max"), FKzVariant::Make<int32>(MAX_int32), None, {}, false },
+			{ TEXT("Int32 min"), FKzVariant::Make<int32>(MIN_int32), None, {}, false },
+			{ TEXT("Int64 small"), FKzVariant::Make<int64>(42), None },
+			{ TEXT("Int64 max"), FKzVariant::Make<int64>(MAX_int64), None, {}, false },
+			{ TEXT("Int64 min"), FKzVariant::Make<int64>(MIN_int64), None, {}, false },
+			{ TEXT("Enum"), FKzVariant::Make<EKzNetQuantization>(EKzNetQuantization::Fixed), None },
+			{ TEXT("Float None"), FKzVariant::Make<float>(3.25f), None },
+			{ TEXT("Float Float"), FKzVariant::Make<float>(3.25f), Float },
+			{ TEXT("Float Fixed(2)"), FKzVariant::Make<float>(3.14159f), MakeQuantization(EKzNetQuantization::Fixed, 2), 3.14 },
+			{ TEXT("Double None"), FKzVariant::Make<double>(Pi), None, {}, false },
+			{ TEXT("Double Float"), FKzVariant::Make<double>(Pi), Float, double(float(Pi)) },
+			{ TEXT("Double Fixed(3) rounding up"), FKzVariant::Make<double>(Pi), MakeQuantization(EKzNetQuantization::Fixed, 3), 3.142 },
+			{ TEXT("Double Fixed(2) negative"), FKzVariant::Make<double>(-2.71828), MakeQuantization(EKzNetQuantization::Fixed, 2), -2.72 },
+			{ TEXT("Double Fixed(9) capped to 7"), FKzVariant::Make<double>(1.23456789), MakeQuantization(EKzNetQuantization::Fixed, 9), 1.2345679 },
+			{ TEXT("String"), FKzVariant::Make<FString>(TEXT("Hello, KzLib")), None },
+			{ TEXT("Struct"), FKzVariant::Make<FVector>(FVector(1.0, 2.0, 3.0)), None },
+		};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKzVariantNetSerializeTest, "KzLib.Variant.NetSerializePacked",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKzVariantNetSerializeTest::RunTest(const FString& Parameters)
+{
+	using namespace KzVariantNetTests;
+
+	/** Bound on the extra cost of a varint over the full-width value (64-bit worst case: 13 groups of 6 bits). */
+	constexpr int64 MaxExtraBits = 16;
+
+	int64 TotalLegacyBits = 0;
+	int64 TotalPackedBits = 0;
+
+	for (FSample& Sample : MakeSamples())
+	{
+		TArray<UObject*> Objects;
+
+		FTestNetBitWriter LegacyWriter(Objects);
+		WriteLegacy(LegacyWriter, Sample.Value);
+
+		FTestNetBitWriter PackedWriter(Objects);
+		bool bSuccess = false;
+		Sample.Value.NetSerializePacked(PackedWriter, nullptr, bSuccess, Sample.Quantization);
+		TestTrue(FString::Printf(TEXT("%s: written"), Sample.Name), bSuccess && !PackedWriter.IsError());
+
+		const int64 LegacyBits = LegacyWriter.GetNumBits();
+		const int64 PackedBits = PackedWriter.GetNumBits();
+		TotalLegacyBits += LegacyBits;
+		TotalPackedBits += PackedBits;
+		AddInfo(FString::Printf(TEXT("%s: %lld bits (was %lld)"), Sample.Name, PackedBits, LegacyBits));
+
+		if (Sample.bSmaller)
+		{
+			TestTrue(FString::Printf(TEXT("%s: packed encoding is smaller"), Sample.Name), PackedBits < LegacyBits);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("%s: packed encoding stays within %lld bits of the legacy one"), Sample.Name, MaxExtraBits), PackedBits <= LegacyBits + MaxExtraBits);
+		}
+
+		FTestNetBitReader Reader(Objects, PackedWriter);
+		FKzVariant Loaded;
+		bSuccess = false;
+		Loaded.NetSerializePacked(Reader, nullptr, bSuccess, FKzNetQuantization());
+		TestTrue(FString::Printf(TEXT("%s: read"), Sample.Name), bSuccess && !Reader.IsError());
+		TestEqual(FString::Printf(TEXT("%s: every bit consumed"), Sample.Name), Reader.GetPosBits(), PackedBits);
+
+		if (Sample.ExpectedReal.IsSet())
+		{
+			TestTrue(FString::Printf(TEXT("%s: type"), Sample.Name), Loaded.GetType() == Sample.Value.GetType());
+			TestEqual(FString::Printf(TEXT("%s: quantised value"), Sample.Name), *static_cast<const double*>(Loaded.GetData()), Sample.ExpectedReal.GetValue(), 1e-9);
+		}
+		else
+		{
+			TestTrue(FString::Printf(TEXT("%s: round trip"), Sample.Name), Loaded == Sample.Value);
+		}
+	}
+
+	AddInfo(FString::Printf(TEXT("Total: %lld bits (was %lld)"), TotalPackedBits, TotalLegacyBits));
+	TestTrue(TEXT("Packed encoding is smaller over the sample set"), TotalPackedBits < TotalLegacyBits);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,11 +5,13 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Core/KzDatabaseAsset.h"
+#include "Core/KzDatabaseResolverSubsystem.h"
 #include "KzDatabaseComponent.generated.h"
 
 /**
  * Acts as the central data registry for an Actor.
- * Assign Database Assets here, and the component routes queries to the correct database in O(1) time based on the requested data type.
+ * Assign Database Assets here, and the component routes queries to the correct database with an array index on the interned type ID (see FKzTypeDef::GetTypeId).
+ * On BeginPlay the asset set is registered with UKzDatabaseResolverSubsystem, which shares one dispatch table between all components assigning the same assets.
  */
 UCLASS(ClassGroup = (Database), meta = (BlueprintSpawnableComponent))
 class KZLIB_API UKzDatabaseComponent : public UActorComponent
@@ -35,20 +37,8 @@ public:
 	template <typename T>
 	bool Resolve(const FKzDatabaseQuery& Query, T& OutValue) const
 	{
-		// 1. Generate the TypeDef locally to use as the Map Key
-		FKzTypeDef SearchType = FKzTypeDef::Make<T>();
-
-		// 2. Find the correct Database Asset for this type
-		if (const TObjectPtr<UKzDatabaseAsset>* FoundAsset = DatabaseMap.Find(SearchType))
-		{
-			if (*FoundAsset)
-			{
-				// 3. Delegate the resolution (scoring & inheritance) to the Asset
-				return (*FoundAsset)->ResolveMatch<T>(Query, OutValue);
-			}
-		}
-
-		return false;
+		// The shared context finds the asset for T and delegates the resolution (scoring & inheritance) to it
+		return Context && Context->Resolve<T>(Query, OutValue);
 	}
 
 	/**
@@ -57,15 +47,19 @@ public:
 	 */
 	UKzDatabaseAsset* GetDatabaseAsset(const FKzTypeDef& SearchType) const
 	{
-		if (const TObjectPtr<UKzDatabaseAsset>* FoundAsset = DatabaseMap.Find(SearchType))
-		{
-			return *FoundAsset;
-		}
-		return nullptr;
+		// A type that was never interned cannot have a database.
+		return GetDatabaseAsset(SearchType.FindTypeId());
+	}
+
+	/** Returns the Database Asset associated with an interned type ID, if any. */
+	UKzDatabaseAsset* GetDatabaseAsset(int32 TypeId) const
+	{
+		return Context ? Context->GetDatabaseAsset(TypeId) : nullptr;
 	}
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
@@ -73,9 +67,8 @@ protected:
 
 private:
 	/**
-	 * Backend map used for runtime lookups.
-	 * Built automatically during BeginPlay from the frontend 'Databases' array.
+	 * Backend context used for runtime lookups, shared with every component assigning the same assets.
+	 * Registered during BeginPlay from the frontend 'Databases' array and owned by the world's resolver subsystem.
 	 */
-	UPROPERTY(Transient)
-	TMap<FKzTypeDef, TObjectPtr<UKzDatabaseAsset>> DatabaseMap;
+	const FKzDatabaseContext* Context = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,380 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Containers/KzHandleArray.h"
+#include <atomic>
+
+namespace Kz
+{
+/**
+ * Thread-safe counterpart of THandleArray with the same handle semantics (index + generation,
+ * stale-handle detection), for producers that add and remove elements from worker threads.
+ *
+ * - Add / Emplace / Remove are lock-free and may run concurrently from any thread.
+ * - IsValid / Find are wait-free: a chunk pointer load plus one atomic state load.
+ * - Elements live in fixed-size chunks that are never reallocated, so growing never moves
+ *   an element out from under a reader.
+ * - Removal only retires an element: the handle becomes stale immediately, but the value is
+ *   destroyed and its slot recycled at the next Compact(). Pointers returned by Find() therefore
+ *   stay dereferenceable until that sync point.
+ *
+ * Compact() must be called while no other thread touches the container (e.g. once per frame).
+ * It destroys retired elements, returns their slots to the free stack and squeezes the holes out
+ * of the dense iteration list.
+ *
+ * Capacity is fixed at ChunkSize * MaxChunks elements; chunks are allocated on first use.
+ */
+#if __cpp_concepts
+template<typename InElementType, CHandleType InHandleType = FKzHandle, int32 ChunkSize = 1024, int32 MaxChunks = 1024>
+#else
+template<typename InElementType, typename InHandleType = FKzHandle, int32 ChunkSize = 1024, int32 MaxChunks = 1024>
+#endif
+class TConcurrentHandleArray
+{
+#if !__cpp_concepts
+	static_assert(TIsHandleType<InHandleType>::Value, "InHandleType must define members 'Index', 'Generation', and be constructible as (int32, int32).");
+#endif
+
+public:
+	using ElementType = InElementType;
+	using HandleType = InHandleType;
+
+	/** Maximum number of elements (live + retired) the container can hold. */
+	static constexpr int32 Capacity = ChunkSize * MaxChunks;
+
+	TConcurrentHandleArray() = default;
+	TConcurrentHandleArray(const TConcurrentHandleArray&) = delete;
+	TConcurrentHandleArray& operator=(const TConcurrentHandleArray&) = delete;
+
+	~TConcurrentHandleArray()
+	{
+		Compact();
+
+		const int32 NumSlots = FMath::Min(SlotHighWater.load(std::memory_order_relaxed), Capacity);
+		for (int32 Index = 0; Index < NumSlots; ++Index)
+		{
+			FSlot& Slot = GetSlot(Index);
+			if (IsActiveState(Slot.State.load(std::memory_order_relaxed)))
+			{
+				DestructItem(&Slot.GetValue());
+			}
+		}
+
+		for (std::atomic<FSlotChunk*>& Chunk : SlotChunks)
+		{
+			delete Chunk.load(std::memory_order_relaxed);
+		}
+		for (std::atomic<FDenseChunk*>& Chunk : DenseChunks)
+		{
+			delete Chunk.load(std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Adds a copy of Value and returns its handle. Safe to call from any thread.
+	 * Extra arguments are perfectly forwarded to the handle constructor.
+	 */
+	template<typename... TArgs>
+	HandleType Add(const ElementType& Value, TArgs&&... Args)
+	{
+		static_assert(std::is_constructible_v<HandleType, int32, int32, TArgs...>, "HandleType must be constructible from (int32, int32, Args...)");
+
+		const int32 Index = AllocateSlot();
+		FSlot& Slot = GetSlot(Index);
+		const int32 Generation = GetGeneration(Slot.State.load(std::memory_order_relaxed)) + 1;
+
+		new (&Slot.GetValue()) ElementType(Value);
+		HandleType Handle(Index, Generation, Forward<TArgs>(Args)...);
+		Publish(Slot, Handle);
+		return Handle;
+	}
+
+	/** Constructs a new element in place from Args and returns its handle. Safe to call from any thread. */
+	template<typename... TArgs>
+	HandleType Emplace(TArgs&&... Args)
+	{
+		const int32 Index = AllocateSlot();
+		FSlot& Slot = GetSlot(Index);
+		const int32 Generation = GetGeneration(Slot.State.load(std::memory_order_relaxed)) + 1;
+
+		new (&Slot.GetValue()) ElementType(Forward<TArgs>(Args)...);
+		HandleType Handle(Index, Generation);
+		Publish(Slot, Handle);
+		return Handle;
+	}
+
+	/**
+	 * Retires the element referenced by Handle. Safe to call from any thread.
+	 * The handle is stale as soon as this returns; the value itself is destroyed at the next Compact().
+	 *
+	 * @return true if this call removed the element (false if the handle was already stale).
+	 */
+	bool Remove(const HandleType& Handle)
+	{
+		FSlot* Slot = FindSlot(Handle.Index);
+		if (!Slot) return false;
+
+		uint32 Expected = MakeState(Handle.Generation, true);
+		if (!Slot->State.compare_exchange_strong(Expected, MakeState(Handle.Generation, false), std::memory_order_acq_rel, std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		LiveCount.fetch_sub(1, std::memory_order_relaxed);
+		Push(RetiredHead, Handle.Index);
+		return true;
+	}
+
+	/** Returns true if the handle references a live element. Wait-free. */
+	bool IsValid(const HandleType& Handle) const
+	{
+		const FSlot* Slot = FindSlot(Handle.Index);
+		return Slot && Slot->State.load(std::memory_order_acquire) == MakeState(Handle.Generation, true);
+	}
+
+	/** Semantic alias of IsValid() for clarity. */
+	bool Contains(const HandleType& Handle) const { return IsValid(Handle); }
+
+	/**
+	 * Returns a pointer to the element, or nullptr if the handle is stale. Wait-free.
+	 * Concurrent writers to the same element must synchronise among themselves.
+	 */
+	ElementType* Find(const HandleType& Handle)
+	{
+		FSlot* Slot = FindSlot(Handle.Index);
+		if (!Slot || Slot->State.load(std::memory_order_acquire) != MakeState(Handle.Generation, true))
+		{
+			return nullptr;
+		}
+		return &Slot->GetValue();
+	}
+
+	/** Const version of Find(). */
+	const ElementType* Find(const HandleType& Handle) const
+	{
+		return const_cast<TConcurrentHandleArray*>(this)->Find(Handle);
+	}
+
+	/** Number of live elements. Approximate while other threads are adding or removing. */
+	int32 Num() const { return LiveCount.load(std::memory_order_relaxed); }
+
+	bool IsEmpty() const { return Num() == 0; }
+
+	/**
+	 * Calls Func(Handle, Element) for every live element, in dense order.
+	 * May run concurrently with Add/Remove: elements added or removed during the walk may or may not be visited.
+	 */
+	template<typename TFunc>
+	void ForEach(TFunc&& Func)
+	{
+		const int32 Count = FMath::Min(DenseCount.load(std::memory_order_acquire), Capacity);
+		for (int32 DenseIndex = 0; DenseIndex < Count; ++DenseIndex)
+		{
+			const FDenseChunk* Chunk = DenseChunks[DenseIndex / ChunkSize].load(std::memory_order_acquire);
+			const int32 Index = Chunk ? Chunk->Indices[DenseIndex % ChunkSize].load(std::memory_order_acquire) : INDEX_NONE;
+			if (Index == INDEX_NONE) continue; // Reserved by an Add that has not published yet
+
+			FSlot& Slot = GetSlot(Index);
+			const uint32 State = Slot.State.load(std::memory_order_acquire);
+			if (IsActiveState(State))
+			{
+				::Invoke(Func, HandleType(Index, GetGeneration(State)), Slot.GetValue());
+			}
+		}
+	}
+
+	/**
+	 * Sync point. Must not run concurrently with any other access.
+	 *
+	 * Destroys retired elements, makes their slots available to Add again (generations keep
+	 * growing, so old handles stay stale) and removes the holes they left in the dense list.
+	 */
+	void Compact()
+	{
+		// Recycle retired slots.
+		uint64 Retired = RetiredHead.exchange(PackHead(0, INDEX_NONE), std::memory_order_acquire);
+		for (int32 Index = UnpackIndex(Retired); Index != INDEX_NONE; )
+		{
+			FSlot& Slot = GetSlot(Index);
+			const int32 Next = Slot.NextFree.load(std::memory_order_relaxed);
+
+			DestructItem(&Slot.GetValue());
+			Push(FreeHead, Index);
+
+			Index = Next;
+		}
+
+		// Squeeze retired (and never published) entries out of the dense list.
+		const int32 Count = FMath::Min(DenseCount.load(std::memory_order_relaxed), Capacity);
+		int32 Write = 0;
+		for (int32 Read = 0; Read < Count; ++Read)
+		{
+			const int32 Index = GetDense(Read).load(std::memory_order_relaxed);
+			if (Index != INDEX_NONE && IsActiveState(GetSlot(Index).State.load(std::memory_order_relaxed)))
+			{
+				GetDense(Write++).store(Index, std::memory_order_relaxed);
+			}
+		}
+		for (int32 i = Write; i < Count; ++i)
+		{
+			GetDense(i).store(INDEX_NONE, std::memory_order_relaxed);
+		}
+		DenseCount.store(Write, std::memory_order_release);
+	}
+
+private:
+	/**
+	 * Slot state: generation in the high 31 bits, "active" in bit 0.
+	 * A fresh slot is generation 0, inactive; each reuse starts a new generation.
+	 */
+	static constexpr uint32 MakeState(int32 Generation, bool bActive) { return ((uint32)Generation << 1) | (bActive ? 1u : 0u); }
+	static constexpr int32 GetGeneration(uint32 State) { return (int32)(State >> 1); }
+	static constexpr bool IsActiveState(uint32 State) { return (State & 1u) != 0; }
+
+	/** Stack heads pack an ABA tag (high 32 bits) with the top slot index (low 32 bits). */
+	static constexpr uint64 PackHead(uint32 Tag, int32 Index) { return ((uint64)Tag << 32) | (uint32)Index; }
+	static constexpr int32 UnpackIndex(uint64 Head) { return (int32)(uint32)Head; }
+	static constexpr uint32 UnpackTag(uint64 Head) { return (uint32)(Head >> 32); }
+
+	struct FSlot
+	{
+		std::atomic<uint32> State{ 0 };
+		std::atomic<int32> NextFree{ INDEX_NONE }; // Link while the slot sits in the free or retired stack
+		TTypeCompatibleBytes<ElementType> Value;
+
+		ElementType& GetValue() { return *Value.GetTypedPtr(); }
+	};
+
+	struct FSlotChunk
+	{
+		FSlot Slots[ChunkSize];
+	};
+
+	struct FDenseChunk
+	{
+		std::atomic<int32> Indices[ChunkSize];
+
+		FDenseChunk()
+		{
+			for (std::atomic<int32>& Index : Indices)
+			{
+				Index.store(INDEX_NONE, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	std::atomic<FSlotChunk*> SlotChunks[MaxChunks] = {};
+	std::atomic<FDenseChunk*> DenseChunks[MaxChunks] = {};
+
+	std::atomic<uint64> FreeHead{ PackHead(0, INDEX_NONE) };    // Slots ready for reuse
+	std::atomic<uint64> RetiredHead{ PackHead(0, INDEX_NONE) }; // Removed slots awaiting Compact()
+
+	std::atomic<int32> SlotHighWater{ 0 }; // Slots ever handed out
+	std::atomic<int32> DenseCount{ 0 };    // Length of the dense list, holes included
+	std::atomic<int32> LiveCount{ 0 };
+
+	/** Pops a recycled slot, or claims a fresh one (allocating its chunk on first use). */
+	int32 AllocateSlot()
+	{
+		int32 Index = Pop(FreeHead);
+		if (Index == INDEX_NONE)
+		{
+			Index = SlotHighWater.fetch_add(1, std::memory_order_relaxed);
+			checkf(Index < Capacity, TEXT("TConcurrentHandleArray is full (%d elements)."), Capacity);
+			EnsureChunk(SlotChunks, Index);
+		}
+		return Index;
+	}
+
+	/** Makes a constructed element visible to readers and appends it to the dense list. */
+	void Publish(FSlot& Slot, const HandleType& Handle)
+	{
+		// If the stored element has a member named "Handle", assign it before publishing
+		if constexpr (requires(ElementType E) { E.Handle = Handle; })
+		{
+			Slot.GetValue().Handle = Handle;
+		}
+
+		// Readers that observe the new state also observe the constructed value.
+		Slot.State.store(MakeState(Handle.Generation, true), std::memory_order_release);
+		LiveCount.fetch_add(1, std::memory_order_relaxed);
+
+		const int32 DenseIndex = DenseCount.fetch_add(1, std::memory_order_relaxed);
+		checkf(DenseIndex < Capacity, TEXT("TConcurrentHandleArray dense list is full; call Compact()."));
+		EnsureChunk(DenseChunks, DenseIndex).Indices[DenseIndex % ChunkSize].store(Handle.Index, std::memory_order_release);
+	}
+
+	/** Lock-free push; the tag is bumped on every change so a concurrent Pop never succeeds on a recycled head. */
+	void Push(std::atomic<uint64>& Head, int32 Index)
+	{
+		FSlot& Slot = GetSlot(Index);
+		uint64 Current = Head.load(std::memory_order_relaxed);
+		do
+		{
+			Slot.NextFree.store(UnpackIndex(Current), std::memory_order_relaxed);
+		}
+		while (!Head.compare_exchange_weak(Current, PackHead(UnpackTag(Current) + 1, Index), std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	/** Lock-free pop. Returns INDEX_NONE when the stack is empty. */
+	int32 Pop(std::atomic<uint64>& Head)
+	{
+		uint64 Current = Head.load(std::memory_order_acquire);
+		for (;;)
+		{
+			const int32 Index = UnpackIndex(Current);
+			if (Index == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			const int32 Next = GetSlot(Index).NextFree.load(std::memory_order_relaxed);
+			if (Head.compare_exchange_weak(Current, PackHead(UnpackTag(Current) + 1, Next), std::memory_order_acquire, std::memory_order_acquire))
+			{
+				return Index;
+			}
+		}
+	}
+
+	/** Allocates the chunk holding Item on first use; racing allocators agree on a single winner. */
+	template<typename TChunk>
+	static TChunk& EnsureChunk(std::atomic<TChunk*>* Chunks, int32 Item)
+	{
+		std::atomic<TChunk*>& Chunk = Chunks[Item / ChunkSize];
+		TChunk* Existing = Chunk.load(std::memory_order_acquire);
+		if (!Existing)
+		{
+			TChunk* NewChunk = new TChunk();
+			if (Chunk.compare_exchange_strong(Existing, NewChunk, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				Existing = NewChunk;
+			}
+			else
+			{
+				delete NewChunk;
+			}
+		}
+		return *Existing;
+	}
+
+	/** Slot lookup for indices known to be allocated. */
+	FSlot& GetSlot(int32 Index) const
+	{
+		return SlotChunks[Index / ChunkSize].load(std::memory_order_acquire)->Slots[Index % ChunkSize];
+	}
+
+	std::atomic<int32>& GetDense(int32 DenseIndex) const
+	{
+		return DenseChunks[DenseIndex / ChunkSize].load(std::memory_order_acquire)->Indices[DenseIndex % ChunkSize];
+	}
+
+	/** Slot lookup for untrusted (handle) indices. */
+	FSlot* FindSlot(int32 Index) const
+	{
+		if (Index < 0 || Index >= Capacity) return nullptr;
+		FSlotChunk* Chunk = SlotChunks[Index / ChunkSize].load(std::memory_order_acquire);
+		return Chunk ? &Chunk->Slots[Index % ChunkSize] : nullptr;
+	}
+};
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Core/KzHandle.h" // Default Handle Type
+#include "Algo/StableSort.h"
 
 namespace Kz
 {
@@ -41,11 +42,17 @@ public:
  *  - Dense storage of active elements.
  *  - Safe handle validation and reuse.
  *  - O(1) Add / Remove / Find operations.
+ *
+ * Dense layout:
+ *  - Array of structures (default): values are stored interleaved with their slot back-reference.
+ *  - Structure of arrays (bInStructOfArrays = true): values and slot back-references live in two
+ *    parallel arrays, so iterating values never pulls the back-references through the cache.
+ *    Prefer it when elements are iterated far more often than they are removed.
  */
 #if __cpp_concepts
-template<typename InElementType, CHandleType InHandleType = FKzHandle, typename InAllocatorType = FDefaultAllocator>
+template<typename InElementType, CHandleType InHandleType = FKzHandle, typename InAllocatorType = FDefaultAllocator, bool bInStructOfArrays = false>
 #else
-template<typename InElementType, typename InHandleType = FKzHandle, typename InAllocatorType = FDefaultAllocator>
+template<typename InElementType, typename InHandleType = FKzHandle, typename InAllocatorType = FDefaultAllocator, bool bInStructOfArrays = false>
 #endif
 class THandleArray
 {
@@ -58,6 +65,8 @@ public:
 	using ElementType = InElementType;
 	using HandleType = InHandleType;
 
+	static constexpr bool bStructOfArrays = bInStructOfArrays;
+
 public:
 	/**
 	 * Removes all elements and invalidates all existing handles,
@@ -65,7 +74,7 @@ public:
 	 */
 	void Reset(SizeType NewSize = 0)
 	{
-		Entries.Reset(NewSize);
+		Dense.Reset(NewSize);
 		Slots.Reset(NewSize);
 		FirstFreeSlot = INDEX_NONE;
 	}
@@ -78,11 +87,18 @@ public:
 	 */
 	void Empty(SizeType Slack = 0)
 	{
-		Entries.Empty(Slack);
+		Dense.Empty(Slack);
 		Slots.Empty(Slack);
 		FirstFreeSlot = INDEX_NONE;
 	}
 
+	/** Preallocates room for at least Number elements (dense storage and slots). */
+	void Reserve(SizeType Number)
+	{
+		Dense.Reserve(Number);
+		Slots.Reserve(Number);
+	}
+
 	/**
 	 * Adds a new element and returns a stable handle referencing it.
 	 * Extra arguments are perfectly forwarded to the handle constructor.
@@ -92,44 +108,54 @@ public:
 	{
 		static_assert(std::is_constructible_v<HandleType, int32, int32, TArgs...>, "HandleType must be constructible from (int32, int32, Args...)");
 
-		SizeType SlotIndex;
-
-		// Reuse slot if available
-		if (FirstFreeSlot != INDEX_NONE)
-		{
-			SlotIndex = FirstFreeSlot;
-			FSlot& Slot = Slots[SlotIndex];
-			FirstFreeSlot = Slot.DualIndex;
-			Slot.bActive = true;
-			++Slot.Generation; // Invalidate old handles
-		}
-		else
-		{
-			SlotIndex = Slots.AddDefaulted();
-			FSlot& Slot = Slots[SlotIndex];
-			Slot.Generation = 1;
-			Slot.bActive = true;
-		}
+		const SizeType SlotIndex = AllocateSlot();
+		const SizeType EntryIndex = Dense.Emplace(SlotIndex, Value);
+		return LinkSlot(SlotIndex, EntryIndex, Forward<TArgs>(Args)...);
+	}
 
-		const SizeType EntryIndex = Entries.AddDefaulted();
-		FEntry& Entry = Entries[EntryIndex];
-		Entry.Value = Value;
-		Entry.SlotIndex = SlotIndex;
+	/**
+	 * Constructs a new element in place from Args and returns a stable handle referencing it.
+	 * Unlike Add(), the value is never default-constructed and then assigned.
+	 */
+	template<typename... TArgs>
+	HandleType Emplace(TArgs&&... Args)
+	{
+		const SizeType SlotIndex = AllocateSlot();
+		const SizeType EntryIndex = Dense.Emplace(SlotIndex, Forward<TArgs>(Args)...);
+		return LinkSlot(SlotIndex, EntryIndex);
+	}
 
-		// Link slot -> entry
-		FSlot& Slot = Slots[SlotIndex];
-		Slot.DualIndex = EntryIndex;
+	/**
+	 * Adds a copy of every value, appending their handles to OutHandles in the same order.
+	 * Storage grows once, freed slots are reused first, and the remaining slots are appended in one block.
+	 */
+	void AddMany(TArrayView<const ElementType> Values, TArray<HandleType>& OutHandles)
+	{
+		const SizeType Count = Values.Num();
+		Dense.Reserve(Dense.Num() + Count);
+		OutHandles.Reserve(OutHandles.Num() + Count);
 
-		// Construct the handle with forwarded args
-		HandleType Handle(SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
+		SizeType Index = 0;
 
-		// If the stored element has a member named "Handle", assign it automatically
-		if constexpr (requires(ElementType E) { E.Handle = Handle; })
+		// Drain the free list first...
+		for (; Index < Count && FirstFreeSlot != INDEX_NONE; ++Index)
 		{
-			Entry.Value.Handle = Handle;
+			const SizeType SlotIndex = AllocateSlot();
+			OutHandles.Add(LinkSlot(SlotIndex, Dense.Emplace(SlotIndex, Values[Index])));
 		}
 
-		return Handle;
+		// ...then claim the rest of the slots as one contiguous block.
+		if (Index < Count)
+		{
+			SizeType SlotIndex = Slots.AddDefaulted(Count - Index);
+			for (; Index < Count; ++Index, ++SlotIndex)
+			{
+				FSlot& Slot = Slots[SlotIndex];
+				Slot.Generation = 1;
+				Slot.bActive = true;
+				OutHandles.Add(LinkSlot(SlotIndex, Dense.Emplace(SlotIndex, Values[Index])));
+			}
+		}
 	}
 
 	/** Removes an element if its handle is valid. */
@@ -147,6 +173,45 @@ public:
 		RemoveInternal(Handle);
 	}
 
+	/**
+	 * Removes every element referenced by a valid handle in the list; stale handles are ignored.
+	 * Freed slots are chained locally and spliced onto the free list once.
+	 *
+	 * @return Number of elements removed.
+	 */
+	SizeType RemoveMany(TArrayView<const HandleType> Handles)
+	{
+		SizeType Removed = 0;
+		SizeType ChainHead = INDEX_NONE;
+		SizeType ChainTail = INDEX_NONE;
+
+		for (const HandleType& Handle : Handles)
+		{
+			if (!IsValid(Handle)) continue;
+
+			RemoveDense(Handle.Index);
+
+			FSlot& Slot = Slots[Handle.Index];
+			Slot.bActive = false;
+			++Slot.Generation;
+			Slot.DualIndex = ChainHead;
+			ChainHead = Handle.Index;
+			if (ChainTail == INDEX_NONE)
+			{
+				ChainTail = Handle.Index;
+			}
+			++Removed;
+		}
+
+		if (ChainTail != INDEX_NONE)
+		{
+			Slots[ChainTail].DualIndex = FirstFreeSlot;
+			FirstFreeSlot = ChainHead;
+		}
+
+		return Removed;
+	}
+
 	/**
 	 * Invokes a user-supplied predicate before removing the element.
 	 *
@@ -159,10 +224,7 @@ public:
 	{
 		if (!IsValid(Handle)) return false;
 
-		FSlot& Slot = Slots[Handle.Index];
-		ElementType& Element = Entries[Slot.DualIndex].Value;
-
-		::Invoke(Predicate, Element);
+		::Invoke(Predicate, Dense.Value(Slots[Handle.Index].DualIndex));
 		RemoveInternal(Handle);
 
 		return true;
@@ -173,15 +235,45 @@ public:
 	void RemoveAfterChecked(const HandleType& Handle, TPredicate Predicate)
 	{
 		check(IsValid(Handle));
-		FSlot& Slot = Slots[Handle.Index];
-		ElementType& Element = Entries[Slot.DualIndex].Value;
 
-		::Invoke(Predicate, Element);
+		::Invoke(Predicate, Dense.Value(Slots[Handle.Index].DualIndex));
 		RemoveInternal(Handle);
 	}
 
+	/**
+	 * Reorders dense storage by a projection of each element (e.g. a spatial key) to improve
+	 * iteration locality. Handles stay valid; only dense indices change. The sort is stable.
+	 *
+	 * @param Projection  Callable: Key(const ElementType&), where Key supports operator<.
+	 */
+	template<typename TProjection>
+	void SortBy(TProjection Projection)
+	{
+		const SizeType Count = Dense.Num();
+		if (Count < 2) return;
+
+		TArray<SizeType> Order;
+		Order.SetNumUninitialized(Count);
+		for (SizeType i = 0; i < Count; ++i)
+		{
+			Order[i] = i;
+		}
+
+		Algo::StableSort(Order, [this, &Projection](SizeType A, SizeType B)
+		{
+			return ::Invoke(Projection, Dense.Value(A)) < ::Invoke(Projection, Dense.Value(B));
+		});
+
+		Dense.ApplyOrder(Order);
+
+		for (SizeType i = 0; i < Count; ++i)
+		{
+			Slots[Dense.SlotIndex(i)].DualIndex = i;
+		}
+	}
+
 	/** Returns the number of currently active elements. */
-	SizeType Num() const { return Entries.Num(); }
+	SizeType Num() const { return Dense.Num(); }
 
 	/**
 	 * Returns true if the array is empty and contains no elements.
@@ -189,7 +281,7 @@ public:
 	 * @returns True if the pool is empty.
 	 * @see Num
 	 */
-	bool IsEmpty() const { return Entries.IsEmpty(); }
+	bool IsEmpty() const { return Dense.Num() == 0; }
 
 	/**
 	 * Tests if index is valid, i.e. greater than or equal to zero, and less than the number of elements in the array.
@@ -197,7 +289,7 @@ public:
 	 * @param Index Index to test.
 	 * @returns True if index is valid. False otherwise.
 	 */
-	bool IsValidIndex(SizeType Index) const { return Entries.IsValidIndex(Index); }
+	bool IsValidIndex(SizeType Index) const { return Index >= 0 && Index < Dense.Num(); }
 
 	/** Returns true if the provided handle is valid. */
 	bool IsValid(const HandleType& Handle) const
@@ -216,15 +308,15 @@ public:
 	{
 		static_assert(std::is_constructible_v<HandleType, int32, int32, TArgs...>, "HandleType must be constructible from (int32, int32, Args...)");
 
-		if (!Entries.IsValidIndex(Index))
+		if (!IsValidIndex(Index))
 		{
 			return HandleType(INDEX_NONE, 0);
 		}
 
-		const FEntry& Entry = Entries[Index];
-		const FSlot& Slot = Slots[Entry.SlotIndex];
+		const SizeType SlotIndex = Dense.SlotIndex(Index);
+		const FSlot& Slot = Slots[SlotIndex];
 		check(Slot.bActive);
-		return HandleType(Entry.SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
+		return HandleType(SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
 	}
 
 	/** Converts a dense index to a handle, forwarding any extra constructor arguments. Assumes index is valid. */
@@ -233,18 +325,18 @@ public:
 	{
 		static_assert(std::is_constructible_v<HandleType, int32, int32, TArgs...>, "HandleType must be constructible from (int32, int32, Args...)");
 
-		check(Entries.IsValidIndex(Index));
-		const FEntry& Entry = Entries[Index];
-		const FSlot& Slot = Slots[Entry.SlotIndex];
+		check(IsValidIndex(Index));
+		const SizeType SlotIndex = Dense.SlotIndex(Index);
+		const FSlot& Slot = Slots[SlotIndex];
 		check(Slot.bActive);
-		return HandleType(Entry.SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
+		return HandleType(SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
 	}
 
 	/** Returns a pointer to the element associated with this handle, or nullptr if invalid. */
 	ElementType* Find(const HandleType& Handle)
 	{
 		if (!IsValid(Handle)) return nullptr;
-		return &Entries[Slots[Handle.Index].DualIndex].Value;
+		return &Dense.Value(Slots[Handle.Index].DualIndex);
 	}
 
 	/** Const version of Find(). */
@@ -257,23 +349,23 @@ public:
 	ElementType& FindChecked(const HandleType& Handle)
 	{
 		check(IsValid(Handle));
-		return Entries[Slots[Handle.Index].DualIndex].Value;
+		return Dense.Value(Slots[Handle.Index].DualIndex);
 	}
 
 	/** Const version of FindChecked(). */
 	const ElementType& FindChecked(const HandleType& Handle) const
 	{
 		check(IsValid(Handle));
-		return Entries[Slots[Handle.Index].DualIndex].Value;
+		return Dense.Value(Slots[Handle.Index].DualIndex);
 	}
 
 	/** Finds all elements that satisfy the given predicate and appends copies to OutElements. */
 	template<typename TPredicate>
 	void FindByPredicate(TArray<ElementType>& OutElements, TPredicate Predicate) const
 	{
-		for (const FEntry& Entry : Entries)
+		for (SizeType i = 0; i < Dense.Num(); ++i)
 		{
-			const ElementType& Element = Entry.Value;
+			const ElementType& Element = Dense.Value(i);
 			if (::Invoke(Predicate, Element))
 			{
 				OutElements.Add(Element);
@@ -285,15 +377,15 @@ public:
 	template<typename TPredicate>
 	void FindHandlesByPredicate(TArray<HandleType>& OutHandles, TPredicate Predicate) const
 	{
-		for (const FEntry& Entry : Entries)
+		for (SizeType i = 0; i < Dense.Num(); ++i)
 		{
-			const ElementType& Element = Entry.Value;
-			if (::Invoke(Predicate, Element))
+			if (::Invoke(Predicate, Dense.Value(i)))
 			{
-				const FSlot& Slot = Slots[Entry.SlotIndex];
+				const SizeType SlotIndex = Dense.SlotIndex(i);
+				const FSlot& Slot = Slots[SlotIndex];
 				if (Slot.bActive)
 				{
-					OutHandles.Add(HandleType(Entry.SlotIndex, Slot.Generation));
+					OutHandles.Add(HandleType(SlotIndex, Slot.Generation));
 				}
 			}
 		}
@@ -308,36 +400,118 @@ public:
 	 */
 	ElementType& operator[](SizeType Index)
 	{
-		check(Entries.IsValidIndex(Index));
-		return Entries[Index].Value;
+		check(IsValidIndex(Index));
+		return Dense.Value(Index);
 	}
 
 	/** Const version of operator[]. */
 	const ElementType& operator[](SizeType Index) const
 	{
-		check(Entries.IsValidIndex(Index));
-		return Entries[Index].Value;
+		check(IsValidIndex(Index));
+		return Dense.Value(Index);
+	}
+
+	/**
+	 * Serializes the complete container state: dense entries, slots (with their generations)
+	 * and the free list, so loaded handles stay valid and freed handles stay stale.
+	 *
+	 * Slots and array-of-structures entries are written field by field, so the container adds no padding
+	 * bytes to the stream and saving the same state always produces the same bytes. Trivially
+	 * copyable element types are written as raw memory. Other element types must provide
+	 * operator<<(FArchive&, ElementType&).
+	 */
+	void Serialize(FArchive& Ar)
+	{
+		SizeType NumEntries = Dense.Num();
+		SizeType NumSlots = Slots.Num();
+		Ar << NumEntries << NumSlots << FirstFreeSlot;
+
+		if (Ar.IsLoading())
+		{
+			Dense.SetNum(NumEntries);
+			Slots.SetNum(NumSlots);
+		}
+
+		Dense.Serialize(Ar);
+		for (FSlot& Slot : Slots)
+		{
+			Ar << Slot.Generation << Slot.DualIndex << Slot.bActive;
+		}
+	}
+
+	/** Saves the container state (see above) from a const container. */
+	void Serialize(FArchive& Ar) const
+	{
+		checkf(!Ar.IsLoading(), TEXT("THandleArray: cannot load into a const container."));
+
+		// FArchive only takes mutable references, but a saving archive never writes through them.
+		const_cast<THandleArray*>(this)->Serialize(Ar);
 	}
 
 private:
-	/** Internal removal logic shared between all Remove* variants. */
-	void RemoveInternal(const HandleType& Handle)
+	/** Pops a free slot (bumping its generation) or appends a new one, and marks it active. */
+	SizeType AllocateSlot()
 	{
-		FSlot& SlotToRemove = Slots[Handle.Index];
-		const SizeType EntryIndex = SlotToRemove.DualIndex;
-		const SizeType LastIndex = Entries.Num() - 1;
+		// Reuse slot if available
+		if (FirstFreeSlot != INDEX_NONE)
+		{
+			const SizeType SlotIndex = FirstFreeSlot;
+			FSlot& Slot = Slots[SlotIndex];
+			FirstFreeSlot = Slot.DualIndex;
+			Slot.bActive = true;
+			++Slot.Generation; // Invalidate old handles
+			return SlotIndex;
+		}
+
+		const SizeType SlotIndex = Slots.AddDefaulted();
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.Generation = 1;
+		Slot.bActive = true;
+		return SlotIndex;
+	}
+
+	/** Links slot -> entry and builds the handle for a freshly added element. */
+	template<typename... TArgs>
+	HandleType LinkSlot(SizeType SlotIndex, SizeType EntryIndex, TArgs&&... Args)
+	{
+		FSlot& Slot = Slots[SlotIndex];
+		Slot.DualIndex = EntryIndex;
+
+		// Construct the handle with forwarded args
+		HandleType Handle(SlotIndex, Slot.Generation, Forward<TArgs>(Args)...);
+
+		// If the stored element has a member named "Handle", assign it automatically
+		if constexpr (requires(ElementType E) { E.Handle = Handle; })
+		{
+			Dense.Value(EntryIndex).Handle = Handle;
+		}
+
+		return Handle;
+	}
+
+	/** Swap-removes the dense entry of a slot, keeping the moved entry's slot in sync. */
+	void RemoveDense(SizeType SlotIndex)
+	{
+		const SizeType EntryIndex = Slots[SlotIndex].DualIndex;
+		const SizeType LastIndex = Dense.Num() - 1;
 
 		// Maintain dense storage by swapping with the last element if needed
 		if (EntryIndex != LastIndex)
 		{
-			Entries[EntryIndex] = MoveTemp(Entries[LastIndex]);
-			FEntry& MovedEntry = Entries[EntryIndex];
-			Slots[MovedEntry.SlotIndex].DualIndex = EntryIndex;
+			Dense.MoveLastTo(EntryIndex);
+			Slots[Dense.SlotIndex(EntryIndex)].DualIndex = EntryIndex;
 		}
 
-		Entries.RemoveAt(LastIndex, EAllowShrinking::No);
+		Dense.Pop();
+	}
+
+	/** Internal removal logic shared between all Remove* variants. */
+	void RemoveInternal(const HandleType& Handle)
+	{
+		RemoveDense(Handle.Index);
 
 		// Invalidate the removed slot and add it back to the free list
+		FSlot& SlotToRemove = Slots[Handle.Index];
 		SlotToRemove.bActive = false;
 		++SlotToRemove.Generation;
 		SlotToRemove.DualIndex = FirstFreeSlot;
@@ -357,9 +531,151 @@ private:
 	{
 		ElementType Value;
 		SizeType SlotIndex = INDEX_NONE;
+
+		FEntry() = default;
+
+		template<typename... TArgs>
+		explicit FEntry(SizeType InSlotIndex, TArgs&&... Args)
+			: Value(Forward<TArgs>(Args)...)
+			, SlotIndex(InSlotIndex)
+		{
+		}
 	};
 
-	TArray<FEntry, InAllocatorType> Entries;   // Dense array of active elements.
+	/** Array-of-structures dense storage: one array of { Value, SlotIndex }. */
+	struct FAoSDense
+	{
+		TArray<FEntry, InAllocatorType> Entries;
+
+		SizeType Num() const { return Entries.Num(); }
+		ElementType& Value(SizeType Index) { return Entries[Index].Value; }
+		const ElementType& Value(SizeType Index) const { return Entries[Index].Value; }
+		SizeType SlotIndex(SizeType Index) const { return Entries[Index].SlotIndex; }
+
+		template<typename... TArgs>
+		SizeType Emplace(SizeType InSlotIndex, TArgs&&... Args) { return Entries.Emplace(InSlotIndex, Forward<TArgs>(Args)...); }
+
+		void MoveLastTo(SizeType Index) { Entries[Index] = MoveTemp(Entries.Last()); }
+		void Pop() { Entries.Pop(EAllowShrinking::No); }
+
+		void Reset(SizeType NewSize) { Entries.Reset(NewSize); }
+		void Empty(SizeType Slack) { Entries.Empty(Slack); }
+		void Reserve(SizeType Number) { Entries.Reserve(Number); }
+		void SetNum(SizeType Number) { Entries.SetNum(Number); }
+
+		void ApplyOrder(const TArray<SizeType>& Order)
+		{
+			TArray<FEntry, InAllocatorType> Sorted;
+			Sorted.Reserve(Entries.Num());
+			for (const SizeType From : Order)
+			{
+				Sorted.Add(MoveTemp(Entries[From]));
+			}
+			Entries = MoveTemp(Sorted);
+		}
+
+		void Serialize(FArchive& Ar)
+		{
+			// Per entry rather than one block: FEntry's tail padding would otherwise reach the stream.
+			for (FEntry& Entry : Entries)
+			{
+				if constexpr (std::is_empty_v<ElementType>)
+				{
+					// Nothing to write: the byte an empty type occupies is never initialized.
+				}
+				else if constexpr (std::is_trivially_copyable_v<ElementType>)
+				{
+					Ar.Serialize(&Entry.Value, sizeof(ElementType));
+				}
+				else
+				{
+					Ar << Entry.Value;
+				}
+				Ar << Entry.SlotIndex;
+			}
+		}
+
+		auto& IterationArray() { return Entries; }
+		const auto& IterationArray() const { return Entries; }
+	};
+
+	/** Structure-of-arrays dense storage: values and slot back-references in parallel arrays. */
+	struct FSoADense
+	{
+		TArray<ElementType, InAllocatorType> Values;
+		TArray<SizeType, InAllocatorType> SlotIndices;
+
+		SizeType Num() const { return Values.Num(); }
+		ElementType& Value(SizeType Index) { return Values[Index]; }
+		const ElementType& Value(SizeType Index) const { return Values[Index]; }
+		SizeType SlotIndex(SizeType Index) const { return SlotIndices[Index]; }
+
+		template<typename... TArgs>
+		SizeType Emplace(SizeType InSlotIndex, TArgs&&... Args)
+		{
+			SlotIndices.Add(InSlotIndex);
+			return Values.Emplace(Forward<TArgs>(Args)...);
+		}
+
+		void MoveLastTo(SizeType Index)
+		{
+			Values[Index] = MoveTemp(Values.Last());
+			SlotIndices[Index] = SlotIndices.Last();
+		}
+
+		void Pop()
+		{
+			Values.Pop(EAllowShrinking::No);
+			SlotIndices.Pop(EAllowShrinking::No);
+		}
+
+		void Reset(SizeType NewSize) { Values.Reset(NewSize); SlotIndices.Reset(NewSize); }
+		void Empty(SizeType Slack) { Values.Empty(Slack); SlotIndices.Empty(Slack); }
+		void Reserve(SizeType Number) { Values.Reserve(Number); SlotIndices.Reserve(Number); }
+		void SetNum(SizeType Number) { Values.SetNum(Number); SlotIndices.SetNum(Number); }
+
+		void ApplyOrder(const TArray<SizeType>& Order)
+		{
+			TArray<ElementType, InAllocatorType> SortedValues;
+			TArray<SizeType, InAllocatorType> SortedSlots;
+			SortedValues.Reserve(Values.Num());
+			SortedSlots.Reserve(Values.Num());
+			for (const SizeType From : Order)
+			{
+				SortedValues.Add(MoveTemp(Values[From]));
+				SortedSlots.Add(SlotIndices[From]);
+			}
+			Values = MoveTemp(SortedValues);
+			SlotIndices = MoveTemp(SortedSlots);
+		}
+
+		void Serialize(FArchive& Ar)
+		{
+			if constexpr (std::is_empty_v<ElementType>)
+			{
+				// Nothing to write: the byte an empty type occupies is never initialized.
+			}
+			else if constexpr (std::is_trivially_copyable_v<ElementType>)
+			{
+				Ar.Serialize(Values.GetData(), (int64)Values.Num() * sizeof(ElementType));
+			}
+			else
+			{
+				for (ElementType& Value : Values)
+				{
+					Ar << Value;
+				}
+			}
+			Ar.Serialize(SlotIndices.GetData(), (int64)SlotIndices.Num() * sizeof(SizeType));
+		}
+
+		auto& IterationArray() { return Values; }
+		const auto& IterationArray() const { return Values; }
+	};
+
+	using FDense = std::conditional_t<bStructOfArrays, FSoADense, FAoSDense>;
+
+	FDense Dense;                              // Dense storage of active elements.
 	TArray<FSlot, InAllocatorType>  Slots;     // Indirection table providing handle indirection.
 	SizeType FirstFreeSlot = INDEX_NONE; // Head of the free slot linked list.
 
@@ -375,8 +691,8 @@ private:
 		TBaseIterator(TArrayIter InIter) : Iter(InIter) {}
 
 		// Accessors
-		auto& operator*() const { return (*Iter).Value; }
-		auto* operator->() const { return &(*Iter).Value; }
+		auto& operator*() const { return GetValue(*Iter); }
+		auto* operator->() const { return &GetValue(*Iter); }
 
 		// Advancement
 		TBaseIterator& operator++() { ++Iter; return *this; }
@@ -387,43 +703,60 @@ private:
 		bool operator!=(const TBaseIterator& Other) const { return Iter != Other.Iter; }
 		bool operator==(const TBaseIterator& Other) const { return Iter == Other.Iter; }
 
-		// Removal support (Delegates to TArray iterator)
-		void RemoveCurrent() { Iter.RemoveCurrent(); }
+		// Not supported: a removal must also free the slot (see RemoveInternal), and the wrapped ranged-for
+		// iterators cannot outlive the dense array shrinking under them. Collect handles and use Remove / RemoveMany.
+		void RemoveCurrent() = delete;
 
 		// Access to internal TArray iterator
 		SizeType GetIndex() const { return Iter.GetIndex(); }
 
 	private:
 		TArrayIter Iter;
+
+		// AoS iterators walk entries, SoA iterators walk the values directly.
+		template<typename TItem>
+		static auto& GetValue(TItem& Item)
+		{
+			if constexpr (bStructOfArrays)
+			{
+				return Item;
+			}
+			else
+			{
+				return Item.Value;
+			}
+		}
 	};
 
+	using FIterationArray = std::conditional_t<bStructOfArrays, TArray<ElementType, InAllocatorType>, TArray<FEntry, InAllocatorType>>;
+
 public:
 	// Define Iterator Types based on the underlying TArray iterators
-	using TIterator = TBaseIterator<typename TArray<FEntry, InAllocatorType>::RangedForIteratorType>;
-	using TConstIterator = TBaseIterator<typename TArray<FEntry, InAllocatorType>::RangedForConstIteratorType>;
-	using TReverseIterator = TBaseIterator<typename TArray<FEntry, InAllocatorType>::RangedForReverseIteratorType>;
-	using TConstReverseIterator = TBaseIterator<typename TArray<FEntry, InAllocatorType>::RangedForConstReverseIteratorType>;
+	using TIterator = TBaseIterator<typename FIterationArray::RangedForIteratorType>;
+	using TConstIterator = TBaseIterator<typename FIterationArray::RangedForConstIteratorType>;
+	using TReverseIterator = TBaseIterator<typename FIterationArray::RangedForReverseIteratorType>;
+	using TConstReverseIterator = TBaseIterator<typename FIterationArray::RangedForConstReverseIteratorType>;
 
 	// --- Factory Methods (Standard Unreal API) ---
 
-	TIterator CreateIterator() { return TIterator(Entries.begin()); }
-	TConstIterator CreateConstIterator() const { return TConstIterator(Entries.begin()); }
+	TIterator CreateIterator() { return TIterator(Dense.IterationArray().begin()); }
+	TConstIterator CreateConstIterator() const { return TConstIterator(Dense.IterationArray().begin()); }
 
-	TReverseIterator CreateReverseIterator() { return TReverseIterator(Entries.rbegin()); }
-	TConstReverseIterator CreateConstReverseIterator() const { return TConstReverseIterator(Entries.rbegin()); }
+	TReverseIterator CreateReverseIterator() { return TReverseIterator(Dense.IterationArray().rbegin()); }
+	TConstReverseIterator CreateConstReverseIterator() const { return TConstReverseIterator(Dense.IterationArray().rbegin()); }
 
 	// --- STL-style Range Support (For loops) ---
 
-	FORCEINLINE TIterator begin() { return TIterator(Entries.begin()); }
-	FORCEINLINE TIterator end() { return TIterator(Entries.end()); }
+	FORCEINLINE TIterator begin() { return TIterator(Dense.IterationArray().begin()); }
+	FORCEINLINE TIterator end() { return TIterator(Dense.IterationArray().end()); }
 
-	FORCEINLINE TConstIterator begin() const { return TConstIterator(Entries.begin()); }
-	FORCEINLINE TConstIterator end() const { return TConstIterator(Entries.end()); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(Dense.IterationArray().begin()); }
+	FORCEINLINE TConstIterator end() const { return TConstIterator(Dense.IterationArray().end()); }
 
-	FORCEINLINE TReverseIterator rbegin() { return TReverseIterator(Entries.rbegin()); }
-	FORCEINLINE TReverseIterator rend() { return TReverseIterator(Entries.rend()); }
+	FORCEINLINE TReverseIterator rbegin() { return TReverseIterator(Dense.IterationArray().rbegin()); }
+	FORCEINLINE TReverseIterator rend() { return TReverseIterator(Dense.IterationArray().rend()); }
 
-	FORCEINLINE TConstReverseIterator rbegin() const { return TConstReverseIterator(Entries.rbegin()); }
-	FORCEINLINE TConstReverseIterator rend() const { return TConstReverseIterator(Entries.rend()); }
+	FORCEINLINE TConstReverseIterator rbegin() const { return TConstReverseIterator(Dense.IterationArray().rbegin()); }
+	FORCEINLINE TConstReverseIterator rend() const { return TConstReverseIterator(Dense.IterationArray().rend()); }
 };
 }
\ No newline at end of file
@@ -303,4 +303,393 @@ namespace Kz
 		FORCEINLINE TConstReverseIterator rbegin() const { return TConstReverseIterator(Stack.rbegin()); }
 		FORCEINLINE TConstReverseIterator rend() const { return TConstReverseIterator(Stack.rend()); }
 	};
+	/**
+	 * Indexed variant of TPriorityStack for stacks that are re-prioritised often.
+	 *
+	 * Keys are unique (pushing an existing key replaces it) and a key -> heap position map is kept
+	 * in sync with every heap move, so keyed operations no longer scan or re-sort the whole heap:
+	 *   - Contains / Find / FindPriority : O(1)
+	 *   - Push / UpdatePriority / Remove : O(log n)
+	 *
+	 * Ordering matches TPriorityStack: higher priority first, and among equal priorities the most
+	 * recently pushed or re-prioritised element wins (LIFO via the sequence counter).
+	 */
+	template <typename TEntry, bool bKeepLastElement = false, typename TKey = TEntry>
+	class TIndexedPriorityStack
+	{
+	private:
+		struct FPriorityEntry;
+
+	public:
+		using TType = TIndexedPriorityStack<TEntry, bKeepLastElement, TKey>;
+
+		void Empty() { Heap.Empty(); Positions.Empty(); SequenceCounter = 0; }
+		bool IsEmpty() const { return Heap.IsEmpty(); }
+		int32 Num() const { return Heap.Num(); }
+
+		// --- Top Access ---
+
+		const TEntry& Top() const { return TopEntry(); }
+		TEntry& Top() { return TopEntry(); }
+
+		const TEntry& TopEntry() const
+		{
+			checkf(Num() > 0, TEXT("Calling TopEntry() on an empty TIndexedPriorityStack!"));
+			return Heap[0].Entry;
+		}
+
+		TEntry& TopEntry()
+		{
+			checkf(Num() > 0, TEXT("Calling TopEntry() on an empty TIndexedPriorityStack!"));
+			return Heap[0].Entry;
+		}
+
+		/** Keys index the heap, so they are only exposed read-only. */
+		const TKey& TopKey() const
+		{
+			checkf(Num() > 0, TEXT("Calling TopKey() on an empty TIndexedPriorityStack!"));
+			return Heap[0].Key;
+		}
+
+		// --- Push ---
+
+		void Push(const TEntry& Entry, int32 Priority)
+		{
+			Push(Entry, Entry, Priority);
+		}
+
+		/** Pushes a new element, or replaces the entry and priority of an existing key. */
+		void Push(const TEntry& Entry, const TKey& Key, int32 Priority)
+		{
+			if (const int32* Position = Positions.Find(Key))
+			{
+				FPriorityEntry& Node = Heap[*Position];
+				Node.Entry = Entry;
+				Node.Priority = Priority;
+				Node.Sequence = SequenceCounter++;
+				Fix(*Position);
+				return;
+			}
+
+			const int32 Index = Heap.Add({ Priority, SequenceCounter++, Entry, Key });
+			Positions.Add(Key, Index);
+			SiftUp(Index);
+		}
+
+		/**
+		 * Changes the priority of an existing key. Counts as a fresh push for tie-breaking.
+		 * @return false if the key is not in the stack.
+		 */
+		bool UpdatePriority(const TKey& Key, int32 NewPriority)
+		{
+			const int32* Position = Positions.Find(Key);
+			if (!Position)
+			{
+				return false;
+			}
+
+			FPriorityEntry& Node = Heap[*Position];
+			Node.Priority = NewPriority;
+			Node.Sequence = SequenceCounter++;
+			Fix(*Position);
+			return true;
+		}
+
+		// --- Pop ---
+
+		/** Removes the top element and discards it. Returns true if an element was removed. */
+		bool Pop()
+		{
+			if (IsEmpty() || (bKeepLastElement && Num() == 1))
+			{
+				return false;
+			}
+
+			RemoveAt(0);
+			return true;
+		}
+
+		/** Removes the top element and moves its value to OutEntry. Returns true if successful. */
+		bool Pop(TEntry& OutEntry)
+		{
+			if (IsEmpty() || (bKeepLastElement && Num() == 1))
+			{
+				return false;
+			}
+
+			OutEntry = MoveTemp(Heap[0].Entry);
+			RemoveAt(0);
+			return true;
+		}
+
+		/** Removes the element with the given key, honouring bKeepLastElement. */
+		bool Pop(const TKey& Key)
+		{
+			if constexpr (bKeepLastElement)
+			{
+				if (Num() <= 1) return false;
+			}
+
+			return Remove(Key) > 0;
+		}
+
+		// --- Find & Query ---
+
+		TEntry* Find(const TKey& Key)
+		{
+			const int32* Position = Positions.Find(Key);
+			return Position ? &Heap[*Position].Entry : nullptr;
+		}
+
+		const TEntry* Find(const TKey& Key) const
+		{
+			const int32* Position = Positions.Find(Key);
+			return Position ? &Heap[*Position].Entry : nullptr;
+		}
+
+		/** Read-only: use UpdatePriority() to change it. */
+		const int32* FindPriority(const TKey& Key) const
+		{
+			const int32* Position = Positions.Find(Key);
+			return Position ? &Heap[*Position].Priority : nullptr;
+		}
+
+		bool Contains(const TKey& Key) const
+		{
+			return Positions.Contains(Key);
+		}
+
+		// --- Utility ---
+
+		template <typename TCallable>
+		void ForEach(TCallable Callable)
+		{
+			for (FPriorityEntry& E : Heap)
+			{
+				::Invoke(Callable, E.Entry);
+			}
+		}
+
+		/** Removes the element with the given key. Returns the number of removed elements (0 or 1). */
+		int32 Remove(const TKey& Key)
+		{
+			const int32* Position = Positions.Find(Key);
+			if (!Position)
+			{
+				return 0;
+			}
+
+			RemoveAt(*Position);
+			return 1;
+		}
+
+		template <typename TPredicate>
+		int32 RemoveAll(TPredicate Predicate)
+		{
+			const int32 Removed = Heap.RemoveAll([&Predicate](const FPriorityEntry& E) { return ::Invoke(Predicate, E.Entry); });
+			if (Removed > 0)
+			{
+				Rebuild();
+			}
+			return Removed;
+		}
+
+		template <typename TPredicate>
+		TArray<TEntry> FilterByPredicate(TPredicate Predicate) const
+		{
+			TArray<TEntry> Result;
+			Result.Reserve(Heap.Num());
+
+			for (const FPriorityEntry& E : Heap)
+			{
+				if (::Invoke(Predicate, E.Entry))
+				{
+					Result.Add(E.Entry);
+				}
+			}
+			return Result;
+		}
+
+		// --- Sorting & Retrieval ---
+
+		/**
+		 * Returns an array of pointers to the elements, strictly sorted by the heap rules.
+		 * O(N log N) time complexity.
+		 */
+		TArray<const TEntry*> GetSortedElements() const
+		{
+			TArray<const FPriorityEntry*> Temp;
+			Temp.Reserve(Heap.Num());
+			for (const FPriorityEntry& E : Heap) Temp.Add(&E);
+
+			Temp.Sort([](const FPriorityEntry& A, const FPriorityEntry& B) { return A.ComesBefore(B); });
+
+			TArray<const TEntry*> Result;
+			Result.Reserve(Temp.Num());
+			for (const FPriorityEntry* E : Temp) Result.Add(&E->Entry);
+
+			return Result;
+		}
+
+		/** Non-const version of GetSortedElements */
+		TArray<TEntry*> GetSortedElements()
+		{
+			TArray<FPriorityEntry*> Temp;
+			Temp.Reserve(Heap.Num());
+			for (FPriorityEntry& E : Heap) Temp.Add(&E);
+
+			Temp.Sort([](const FPriorityEntry& A, const FPriorityEntry& B) { return A.ComesBefore(B); });
+
+			TArray<TEntry*> Result;
+			Result.Reserve(Temp.Num());
+			for (FPriorityEntry* E : Temp) Result.Add(&E->Entry);
+
+			return Result;
+		}
+
+	private:
+
+		struct FPriorityEntry
+		{
+			int32 Priority;
+			uint64 Sequence; // Used for stable insertion (LIFO for same priority)
+			TEntry Entry;
+			TKey Key;
+
+			/** True if this entry must sit above Other in the heap. */
+			bool ComesBefore(const FPriorityEntry& Other) const
+			{
+				if (Priority == Other.Priority)
+				{
+					return Sequence > Other.Sequence;
+				}
+				return Priority > Other.Priority;
+			}
+		};
+
+		TArray<FPriorityEntry> Heap;
+		TMap<TKey, int32> Positions; // Key -> index in Heap
+		uint64 SequenceCounter = 0;
+
+		static int32 Parent(int32 Index) { return (Index - 1) / 2; }
+
+		/** Moves the node at Index to where it belongs after its ordering changed. */
+		void Fix(int32 Index)
+		{
+			if (Index > 0 && Heap[Index].ComesBefore(Heap[Parent(Index)]))
+			{
+				SiftUp(Index);
+			}
+			else
+			{
+				SiftDown(Index);
+			}
+		}
+
+		void SiftUp(int32 Index)
+		{
+			while (Index > 0)
+			{
+				const int32 ParentIndex = Parent(Index);
+				if (!Heap[Index].ComesBefore(Heap[ParentIndex]))
+				{
+					break;
+				}
+
+				SwapNodes(Index, ParentIndex);
+				Index = ParentIndex;
+			}
+		}
+
+		void SiftDown(int32 Index)
+		{
+			const int32 Count = Heap.Num();
+			for (;;)
+			{
+				const int32 Left = Index * 2 + 1;
+				const int32 Right = Left + 1;
+
+				int32 Best = Index;
+				if (Left < Count && Heap[Left].ComesBefore(Heap[Best])) Best = Left;
+				if (Right < Count && Heap[Right].ComesBefore(Heap[Best])) Best = Right;
+
+				if (Best == Index)
+				{
+					break;
+				}
+
+				SwapNodes(Index, Best);
+				Index = Best;
+			}
+		}
+
+		void SwapNodes(int32 A, int32 B)
+		{
+			Heap.Swap(A, B);
+			Positions.FindChecked(Heap[A].Key) = A;
+			Positions.FindChecked(Heap[B].Key) = B;
+		}
+
+		void RemoveAt(int32 Index)
+		{
+			Positions.Remove(Heap[Index].Key);
+
+			const int32 LastIndex = Heap.Num() - 1;
+			if (Index != LastIndex)
+			{
+				Heap[Index] = MoveTemp(Heap[LastIndex]);
+				Heap.Pop(EAllowShrinking::No);
+				Positions.FindChecked(Heap[Index].Key) = Index;
+				Fix(Index);
+			}
+			else
+			{
+				Heap.Pop(EAllowShrinking::No);
+			}
+		}
+
+		/** Re-heapifies everything and rebuilds the position map (after bulk removals). */
+		void Rebuild()
+		{
+			Positions.Reset();
+			for (int32 Index = 0; Index < Heap.Num(); ++Index)
+			{
+				Positions.Add(Heap[Index].Key, Index);
+			}
+			for (int32 Index = Heap.Num() / 2 - 1; Index >= 0; --Index)
+			{
+				SiftDown(Index);
+			}
+		}
+
+	// =========================================================================
+	//  Iterator Support
+	// =========================================================================
+	private:
+		template<typename TArrayIter>
+		struct TBaseIterator
+		{
+			TBaseIterator(TArrayIter InIter) : Iter(InIter) {}
+			auto& operator*() const { return (*Iter).Entry; }
+			auto* operator->() const { return &(*Iter).Entry; }
+			TBaseIterator& operator++() { ++Iter; return *this; }
+			explicit operator bool() const { return (bool)Iter; }
+			bool operator!=(const TBaseIterator& Other) const { return Iter != Other.Iter; }
+			bool operator==(const TBaseIterator& Other) const { return Iter == Other.Iter; }
+		private:
+			TArrayIter Iter;
+		};
+
+	public:
+		using TIterator = TBaseIterator<typename TArray<FPriorityEntry>::RangedForIteratorType>;
+		using TConstIterator = TBaseIterator<typename TArray<FPriorityEntry>::RangedForConstIteratorType>;
+
+		TIterator CreateIterator() { return TIterator(Heap.begin()); }
+		TConstIterator CreateConstIterator() const { return TConstIterator(Heap.begin()); }
+
+		FORCEINLINE TIterator begin() { return TIterator(Heap.begin()); }
+		FORCEINLINE TIterator end() { return TIterator(Heap.end()); }
+		FORCEINLINE TConstIterator begin() const { return TConstIterator(Heap.begin()); }
+		FORCEINLINE TConstIterator end() const { return TConstIterator(Heap.end()); }
+	};
 }
\ No newline at end of file
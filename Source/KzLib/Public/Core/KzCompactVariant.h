@@ -0,0 +1,294 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/KzVariant.h"
+#include "Templates/TypeCompatibleBytes.h"
+#include "KzCompactVariant.generated.h"
+
+namespace KzCompactVariant
+{
+	/** Payload of a compact variant: the active value inline, or a pointer to it for types with heap storage. */
+	union FStorage
+	{
+		bool BoolValue;
+		uint8 ByteValue;
+		int32 Int32Value;
+		/** Int64 and Enum. */
+		int64 Int64Value;
+		/** Float and Double, stored as double like FKzVariant. */
+		double DoubleValue;
+		TTypeCompatibleBytes<FName> NameValue;
+		TTypeCompatibleBytes<TObjectPtr<UObject>> ObjectValue;
+		TTypeCompatibleBytes<TObjectPtr<UClass>> ClassValue;
+		/** String, Text, Struct, SoftObject and SoftClass. */
+		void* HeapValue;
+	};
+}
+
+/**
+ * Runtime companion of FKzVariant holding only the active value.
+ *
+ * FKzVariant keeps one reflected slot per supported type, which makes it well over 100 bytes and
+ * makes construction, copies and Reset touch every slot. This type stores the type tag, the type
+ * object and a single payload: scalars, names and object references inline, strings, text, soft
+ * references and structs in one heap allocation. GetData returns the value in the same
+ * representation as FKzVariant::GetData, so code writing through it works on both.
+ *
+ * Converts losslessly to and from FKzVariant. Meant for hot paths and transient storage; serialized
+ * data and editable properties should keep using FKzVariant.
+ *
+ * Usage:
+ *   FKzCompactVariant V = FKzCompactVariant::Make<float>(100.0f);
+ *   if (V.Is<float>()) { float X = V.Get<float>(); }
+ *   V.Set<int32>(42);
+ */
+USTRUCT()
+struct KZLIB_API FKzCompactVariant
+{
+	GENERATED_BODY()
+
+public:
+	FKzCompactVariant() = default;
+	~FKzCompactVariant() { Reset(); }
+
+	FKzCompactVariant(const FKzCompactVariant& Other);
+	FKzCompactVariant(FKzCompactVariant&& Other);
+	FKzCompactVariant& operator=(const FKzCompactVariant& Other);
+	FKzCompactVariant& operator=(FKzCompactVariant&& Other);
+
+	/** Lossless conversion from the reflected variant. */
+	explicit FKzCompactVariant(const FKzVariant& Variant) { CopyFrom(Variant); }
+
+	/** Lossless conversion to the reflected variant. */
+	FKzVariant ToVariant() const;
+
+	/** Replaces the held value with a copy of Variant's. */
+	void CopyFrom(const FKzVariant& Variant);
+
+	/** Overwrites Variant with a copy of the held value. */
+	void CopyTo(FKzVariant& Variant) const;
+
+	/** True if the variant holds a value of any supported type. */
+	bool IsValid() const { return Type != EPropertyBagPropertyType::None; }
+
+	/** Releases the held value and resets the variant to an empty (invalid) state. */
+	void Reset();
+
+	/** Returns the bag-level type of the held value. */
+	EPropertyBagPropertyType GetType() const { return Type; }
+
+	/** Resets the value and sets the type. The new value is default-initialized, seeded as FKzVariant::SetType does. */
+	void SetType(EPropertyBagPropertyType NewType, const UObject* NewTypeObject = nullptr);
+
+	/** Returns the optional UObject describing the type (UEnum, UScriptStruct, UClass), as FKzVariant::GetTypeObject. */
+	const UObject* GetTypeObject() const;
+
+	/** Returns true if the variant holds a value compatible with type T. */
+	template <typename T>
+	bool Is() const;
+
+	/** Reads the value as type T. Asserts in debug if the type doesn't match. */
+	template <typename T>
+	T Get() const;
+
+	/** Stores a value of type T, overwriting any previous content. */
+	template <typename T>
+	void Set(const T& Value);
+
+	/** Constructs a new variant holding the given value. */
+	template <typename T>
+	static FKzCompactVariant Make(const T& Value);
+
+	/** True if TypeDef and the variant's type are compatible. */
+	bool MatchesType(const FKzTypeDef& TypeDef) const;
+
+	/** Returns a pointer to the held value in FKzVariant::GetData's representation, or nullptr if invalid. */
+	void* GetData();
+	const void* GetData() const;
+
+	bool Serialize(FArchive& Ar);
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	void AddStructReferencedObjects(FReferenceCollector& Collector);
+	bool operator==(const FKzCompactVariant& Other) const;
+	bool operator!=(const FKzCompactVariant& Other) const { return !(*this == Other); }
+
+private:
+	/** True for types whose value lives in HeapValue. */
+	static bool UsesHeap(EPropertyBagPropertyType InType)
+	{
+		return InType == EPropertyBagPropertyType::String || InType == EPropertyBagPropertyType::Text || InType == EPropertyBagPropertyType::Struct
+			|| InType == EPropertyBagPropertyType::SoftObject || InType == EPropertyBagPropertyType::SoftClass;
+	}
+
+	/** SetType, unless the variant already holds that type, in which case the current payload is reused as is. */
+	void PrepareType(EPropertyBagPropertyType NewType, const UObject* NewTypeObject);
+
+	const UScriptStruct* GetScriptStruct() const
+	{
+		return Type == EPropertyBagPropertyType::Struct ? static_cast<const UScriptStruct*>(TypeObject.Get()) : nullptr;
+	}
+
+	template <typename T>
+	T& As() { return *static_cast<T*>(GetData()); }
+
+	template <typename T>
+	const T& As() const { return *static_cast<const T*>(GetData()); }
+
+	EPropertyBagPropertyType Type = EPropertyBagPropertyType::None;
+
+	/** The enum, struct, or expected class of soft references. Unused for Object and Class, whose type comes from the value. */
+	TObjectPtr<UObject> TypeObject = nullptr;
+
+	KzCompactVariant::FStorage Storage{};
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzCompactVariant> : public TStructOpsTypeTraitsBase2<FKzCompactVariant>
+{
+	enum
+	{
+		WithSerializer = true,
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+		WithAddStructReferencedObjects = true,
+	};
+};
+
+// =====================================================================================
+// Templated API implementation
+// =====================================================================================
+
+template <typename T>
+bool FKzCompactVariant::Is() const
+{
+	using Traits = KzPropertyBag::TPropertyBagType<T>;
+	if (Type != Traits::Type)
+	{
+		return false;
+	}
+
+	// Same rules as FKzVariant::Is: untyped on either side is compatible, object refs are polymorphic, the rest is exact.
+	const UObject* ExpectedTypeObj = Traits::GetObjectType();
+	const UObject* HeldTypeObj = GetTypeObject();
+	if (ExpectedTypeObj == nullptr || HeldTypeObj == nullptr)
+	{
+		return true;
+	}
+
+	if (Type == EPropertyBagPropertyType::Object ||
+		Type == EPropertyBagPropertyType::SoftObject ||
+		Type == EPropertyBagPropertyType::Class ||
+		Type == EPropertyBagPropertyType::SoftClass)
+	{
+		const UClass* ExpectedClass = Cast<UClass>(ExpectedTypeObj);
+		const UClass* HeldClass = Cast<UClass>(HeldTypeObj);
+		return ExpectedClass && HeldClass && HeldClass->IsChildOf(ExpectedClass);
+	}
+
+	return ExpectedTypeObj == HeldTypeObj;
+}
+
+template <typename T>
+T FKzCompactVariant::Get() const
+{
+	checkf(Is<T>(), TEXT("FKzCompactVariant::Get<T>: type mismatch"));
+
+	using Traits = KzPropertyBag::TPropertyBagType<T>;
+
+	if constexpr (std::is_same_v<T, bool>) { return Storage.BoolValue; }
+	else if constexpr (std::is_same_v<T, uint8>) { return Storage.ByteValue; }
+	else if constexpr (std::is_same_v<T, int32>) { return Storage.Int32Value; }
+	else if constexpr (std::is_same_v<T, int64>) { return Storage.Int64Value; }
+	else if constexpr (std::is_same_v<T, float>) { return static_cast<float>(Storage.DoubleValue); }
+	else if constexpr (std::is_same_v<T, double>) { return Storage.DoubleValue; }
+	else if constexpr (std::is_same_v<T, FName>) { return As<FName>(); }
+	else if constexpr (std::is_same_v<T, FString>) { return As<FString>(); }
+	else if constexpr (std::is_same_v<T, FText>) { return As<FText>(); }
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Enum)
+	{
+		return static_cast<T>(Storage.Int64Value);
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Struct)
+	{
+		return As<T>();
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Object)
+	{
+		// T is T* or TObjectPtr<T>. Both convert from raw UObject*.
+		return Cast<std::remove_pointer_t<std::decay_t<T>>>(As<TObjectPtr<UObject>>().Get());
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftObject)
+	{
+		return T(As<TSoftObjectPtr<UObject>>().ToSoftObjectPath());
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Class)
+	{
+		return T(As<TObjectPtr<UClass>>().Get());
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftClass)
+	{
+		return T(As<TSoftClassPtr<UObject>>().ToSoftObjectPath());
+	}
+	else
+	{
+		static_assert(sizeof(T) == 0, "FKzCompactVariant::Get<T>: unsupported type");
+		return T{};
+	}
+}
+
+template <typename T>
+void FKzCompactVariant::Set(const T& Value)
+{
+	using Traits = KzPropertyBag::TPropertyBagType<T>;
+
+	// Keeps the payload (and its heap allocation) when the type is unchanged, only the value is written.
+	PrepareType(Traits::Type, Traits::GetObjectType());
+
+	if constexpr (std::is_same_v<T, bool>) { Storage.BoolValue = Value; }
+	else if constexpr (std::is_same_v<T, uint8>) { Storage.ByteValue = Value; }
+	else if constexpr (std::is_same_v<T, int32>) { Storage.Int32Value = Value; }
+	else if constexpr (std::is_same_v<T, int64>) { Storage.Int64Value = Value; }
+	else if constexpr (std::is_same_v<T, float>) { Storage.DoubleValue = Value; }
+	else if constexpr (std::is_same_v<T, double>) { Storage.DoubleValue = Value; }
+	else if constexpr (std::is_same_v<T, FName>) { As<FName>() = Value; }
+	else if constexpr (std::is_same_v<T, FString>) { As<FString>() = Value; }
+	else if constexpr (std::is_same_v<T, FText>) { As<FText>() = Value; }
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Enum)
+	{
+		Storage.Int64Value = static_cast<int64>(Value);
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Struct)
+	{
+		As<T>() = Value;
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Object)
+	{
+		As<TObjectPtr<UObject>>() = Value;
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftObject)
+	{
+		As<TSoftObjectPtr<UObject>>() = TSoftObjectPtr<UObject>(Value.ToSoftObjectPath());
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::Class)
+	{
+		As<TObjectPtr<UClass>>() = Value.Get();
+	}
+	else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftClass)
+	{
+		As<TSoftClassPtr<UObject>>() = TSoftClassPtr<UObject>(Value.ToSoftObjectPath());
+	}
+	else
+	{
+		static_assert(sizeof(T) == 0, "FKzCompactVariant::Set<T>: unsupported type");
+	}
+}
+
+template <typename T>
+FKzCompactVariant FKzCompactVariant::Make(const T& Value)
+{
+	FKzCompactVariant V;
+	V.Set<T>(Value);
+	return V;
+}
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "HAL/CriticalSection.h"
 #include "StructUtils/PropertyBag.h"
 #include "Core/KzTypeDef.h"
 #include "Core/KzVariant.h"
+#include "Core/KzCompactVariant.h"
 #include "KzDatabase.generated.h"
 
 /**
@@ -45,6 +47,32 @@ struct KZLIB_API FKzDatabaseQuery
 
 	/** Returns true if the query has no constraints */
 	bool IsEmpty() const;
+
+	bool operator==(const FKzDatabaseQuery& Other) const
+	{
+		return RequireTags == Other.RequireTags && IgnoreTags == Other.IgnoreTags && OptionalTags == Other.OptionalTags && TagQuery == Other.TagQuery;
+	}
+
+	/** Stable hash of the query contents (tag order included), e.g. for result caches. */
+	friend uint32 GetTypeHash(const FKzDatabaseQuery& Query)
+	{
+		uint32 Hash = 0;
+		for (const FGameplayTagContainer* Tags : { &Query.RequireTags, &Query.IgnoreTags, &Query.OptionalTags })
+		{
+			Hash = HashCombineFast(Hash, ::GetTypeHash(Tags->Num()));
+			for (const FGameplayTag& Tag : *Tags)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+			}
+		}
+
+		// Only the tags of the expression are hashed, operator== tells expressions over the same tags apart.
+		for (const FGameplayTag& Tag : Query.TagQuery.GetGameplayTagArray())
+		{
+			Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+		}
+		return Hash;
+	}
 };
 
 /** A single entry in the database. */
@@ -91,6 +119,339 @@ public:
 	}
 };
 
+/**
+ * Acceleration structure over the tags of a database's items. Built lazily by FKzDatabase
+ * on the first indexed query after a change (see FKzDatabase::GetItemRevision).
+ *
+ * - Postings maps each tag to the ascending list of item indices carrying it (or a child of
+ *   it), so required tags narrow the candidates by intersecting lists.
+ * - Every tag seen in the items, parents included, gets a bit. Each item stores two fixed-width
+ *   bitsets over those bits (hierarchical and explicit tags), so the remaining checks against a
+ *   compiled query are a few AND / popcount operations per item.
+ */
+struct KZLIB_API FKzDatabaseTagIndex
+{
+	/** Items carrying the tag or any of its children (hierarchical match, as HasAll / HasAny). */
+	TMap<FGameplayTag, TArray<int32>> Postings;
+
+	/** Bit assigned to each tag used by the items, parents included. */
+	TMap<FGameplayTag, int32> TagBits;
+
+	/** Tag of each bit (the inverse of TagBits). */
+	TArray<FGameplayTag> BitTags;
+
+	/** Width of a single item bitset, in 64-bit words. */
+	int32 NumWords = 0;
+
+	/** Per-item bitsets, NumWords per item back to back: tags with their parents, and explicit tags only. */
+	TArray<uint64> ItemBits;
+	TArray<uint64> ExactBits;
+
+	/** Number of items the index was built from, or INDEX_NONE when it needs a rebuild. */
+	int32 NumIndexed = INDEX_NONE;
+
+	/** Item revision of the owning database the index was built at. */
+	uint32 ItemRevision = 0;
+
+	/** Bumped by every Build, compiled queries are only valid for the revision they were compiled against. */
+	uint32 Revision = 0;
+
+	void Build(const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision);
+
+	/**
+	 * Saves the tag table and item bitsets of a built index, or loads them back as an index over NumItems items
+	 * at InItemRevision. Posting lists are not stored, loading derives them from the bitsets.
+	 */
+	void Serialize(FArchive& Ar, int32 NumItems, uint32 InItemRevision);
+
+	/** The item count also catches direct edits of FKzDatabase::Items that skipped InvalidateIndex. */
+	bool IsUpToDate(const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision) const
+	{
+		return ItemRevision == InItemRevision && NumIndexed == Items.Num();
+	}
+
+	const uint64* GetItemBits(int32 ItemIndex) const
+	{
+		return ItemBits.GetData() + ItemIndex * NumWords;
+	}
+
+	const uint64* GetExactBits(int32 ItemIndex) const
+	{
+		return ExactBits.GetData() + ItemIndex * NumWords;
+	}
+};
+
+/**
+ * A FGameplayTagQuery compiled to flat postfix code over the tag bitsets of one database index.
+ *
+ * Leaves test an item bitset against a tag mask (ANY / ALL, hierarchical or exact), nodes fold
+ * their children with AND / OR, and NONE variants are negated leaves or nodes. Evaluation works on
+ * 64-item lanes, one bit per item, so a whole block of candidates goes through the program at once
+ * instead of re-interpreting the query's token stream for every item.
+ */
+struct KZLIB_API FKzDatabaseTagProgram
+{
+	enum class EOp : uint8
+	{
+		/** Arg is 1 for true, 0 for false. */
+		Constant,
+		/** Arg is the offset of the tag mask in Masks. */
+		AnyTags,
+		AllTags,
+		/** Arg is the number of child results to fold off the stack. */
+		AnyExpr,
+		AllExpr,
+	};
+
+	struct FInstruction
+	{
+		EOp Op = EOp::Constant;
+
+		/** Tag leaves test the explicit bitset instead of the hierarchical one. */
+		bool bExact = false;
+
+		/** The result is inverted (NONE expressions). */
+		bool bNegate = false;
+
+		int32 Arg = 0;
+	};
+
+	TArray<FInstruction> Code;
+
+	/** Tag masks, NumWords per tag leaf. */
+	TArray<uint64> Masks;
+
+	int32 NumWords = 0;
+
+	/** Index revision the masks refer to. */
+	uint32 Revision = 0;
+
+	/** Compiles Query against Index. An empty query compiles to an empty program, which matches everything. */
+	void Compile(const FGameplayTagQuery& Query, const FKzDatabaseTagIndex& Index);
+
+	bool IsEmpty() const
+	{
+		return Code.IsEmpty();
+	}
+
+	/** Evaluates up to 64 items of Index at once. Bit N of the result is set if ItemIndices[N] matches. */
+	uint64 MatchesBatch(const FKzDatabaseTagIndex& Index, TConstArrayView<int32> ItemIndices) const;
+
+	bool Matches(const FKzDatabaseTagIndex& Index, int32 ItemIndex) const
+	{
+		return MatchesBatch(Index, MakeArrayView(&ItemIndex, 1)) != 0;
+	}
+
+private:
+	void Emit(const FGameplayTagQueryExpression& Expr, const FKzDatabaseTagIndex& Index);
+	void EmitTags(EOp Op, bool bExact, bool bNegate, const TArray<FGameplayTag>& Tags, const FKzDatabaseTagIndex& Index);
+};
+
+/**
+ * Compiled TagQuery programs of one database, keyed by query. Programs are shared between the
+ * threads querying the database and dropped when the tag index is rebuilt. Copies start empty.
+ */
+struct KZLIB_API FKzDatabaseTagProgramCache
+{
+	/** Bounds the cache for databases queried with many one-off expressions. */
+	static constexpr int32 MaxPrograms = 256;
+
+	FKzDatabaseTagProgramCache() = default;
+	FKzDatabaseTagProgramCache(const FKzDatabaseTagProgramCache&) {}
+	FKzDatabaseTagProgramCache& operator=(const FKzDatabaseTagProgramCache&)
+	{
+		Reset();
+		return *this;
+	}
+
+	/** Returns the program of Query for the current revision of Index, compiling it on first use. */
+	TSharedRef<const FKzDatabaseTagProgram> FindOrCompile(const FGameplayTagQuery& Query, const FKzDatabaseTagIndex& Index);
+
+	void Reset();
+
+private:
+	/** FGameplayTagQuery has no hash of its own; hash the tags it references, equality tells expressions apart. */
+	struct FKeyFuncs : TDefaultMapKeyFuncs<FGameplayTagQuery, TSharedRef<const FKzDatabaseTagProgram>, false>
+	{
+		static uint32 GetKeyHash(const FGameplayTagQuery& Query)
+		{
+			uint32 Hash = 0;
+			for (const FGameplayTag& Tag : Query.GetGameplayTagArray())
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Tag));
+			}
+			return Hash;
+		}
+	};
+
+	FRWLock Lock;
+	uint32 Revision = 0;
+	TMap<FGameplayTagQuery, TSharedRef<const FKzDatabaseTagProgram>, FDefaultSetAllocator, FKeyFuncs> Programs;
+};
+
+/**
+ * A FKzDatabaseQuery lowered to bit masks over the tags of one database (see FKzDatabase::CompileQuery),
+ * with its TagQuery compiled to a FKzDatabaseTagProgram.
+ */
+struct KZLIB_API FKzDatabaseCompiledQuery
+{
+	TArray<uint64, TInlineAllocator<4>> RequireMask;
+	TArray<uint64, TInlineAllocator<4>> IgnoreMask;
+	TArray<uint64, TInlineAllocator<4>> OptionalMask;
+
+	/** The compiled TagQuery, null when the query has none. */
+	TSharedPtr<const FKzDatabaseTagProgram> TagProgram;
+
+	/** Index revision the masks refer to. */
+	uint32 Revision = 0;
+
+	/** True if a required tag is carried by no item, so nothing can match. */
+	bool bUnsatisfiable = false;
+
+	/** Hard requirements (Require, Ignore) against an item's hierarchical bitset. */
+	bool Matches(const uint64* Bits) const
+	{
+		for (int32 Word = 0; Word < RequireMask.Num(); ++Word)
+		{
+			if ((Bits[Word] & RequireMask[Word]) != RequireMask[Word] || (Bits[Word] & IgnoreMask[Word]) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Number of OptionalTags present on an item, given its explicit bitset. */
+	int32 CalculateScore(const uint64* Bits) const
+	{
+		int32 Score = 0;
+		for (int32 Word = 0; Word < OptionalMask.Num(); ++Word)
+		{
+			Score += FMath::CountBits(Bits[Word] & OptionalMask[Word]);
+		}
+		return Score;
+	}
+};
+
+/**
+ * The values of a database's items stored contiguously in their native type (float, FName, a struct...),
+ * rather than one multi-slot FKzVariant per item. Built from FKzDatabase::Items, which stay the source of truth.
+ * Copies start out stale and are rebuilt on first use.
+ */
+struct KZLIB_API FKzDatabaseValueColumn
+{
+	FKzDatabaseValueColumn() = default;
+	FKzDatabaseValueColumn(const FKzDatabaseValueColumn&) {}
+	FKzDatabaseValueColumn& operator=(const FKzDatabaseValueColumn&) { Reset(); return *this; }
+	~FKzDatabaseValueColumn() { Reset(); }
+
+	/**
+	 * Copies every item value into the column, stamped with the owning database's item revision.
+	 * Items whose value does not hold Type get a default value; Float and Double values are accepted for either real type.
+	 */
+	void Build(const FKzTypeDef& Type, const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision);
+
+	/** Destroys the stored values and frees the column. */
+	void Reset();
+
+	/** Number of stored values (zero for unsupported types). */
+	int32 GetNum() const
+	{
+		return Num;
+	}
+
+	/** Writes the value at Index into a variant of the column type. */
+	void CopyTo(int32 Index, FKzVariant& OutValue) const;
+	void CopyTo(int32 Index, FKzCompactVariant& OutValue) const;
+
+	/** Saves the column, or loads it as a column of NumItems values of Type at InItemRevision. Numeric columns are a single block. */
+	void Serialize(FArchive& Ar, const FKzTypeDef& Type, int32 NumItems, uint32 InItemRevision);
+
+	void Invalidate()
+	{
+		NumBuilt = INDEX_NONE;
+	}
+
+	/** The column must match the current type as well as the items: FKzDatabase::Type can be assigned directly. */
+	bool IsUpToDate(const FKzTypeDef& Type, const TArray<FKzDatabaseItem>& Items, uint32 InItemRevision) const
+	{
+		return ItemRevision == InItemRevision && NumBuilt == Items.Num() && ValueType == Type.ValueType && TypeObject == Type.ValueTypeObject;
+	}
+
+	/** Reads the value at Index as type T, which must match the column type (as FKzVariant::Get). */
+	template <typename T>
+	T Get(int32 Index) const
+	{
+		using Traits = KzPropertyBag::TPropertyBagType<T>;
+		checkf(Traits::Type == ValueType, TEXT("FKzDatabaseValueColumn::Get<T>: type mismatch"));
+		check(Index >= 0 && Index < Num);
+
+		if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, uint8> || std::is_same_v<T, int32> || std::is_same_v<T, int64> ||
+			std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, FName> || std::is_same_v<T, FString> || std::is_same_v<T, FText>)
+		{
+			return At<T>(Index);
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::Enum)
+		{
+			return static_cast<T>(At<int64>(Index));
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::Struct)
+		{
+			checkf(TypeObject == Traits::GetObjectType(), TEXT("FKzDatabaseValueColumn::Get<T>: struct mismatch"));
+			return At<T>(Index);
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::Object)
+		{
+			return Cast<std::remove_pointer_t<std::decay_t<T>>>(At<TObjectPtr<UObject>>(Index).Get());
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftObject)
+		{
+			return T(At<TSoftObjectPtr<UObject>>(Index).ToSoftObjectPath());
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::Class)
+		{
+			return T(At<TObjectPtr<UClass>>(Index).Get());
+		}
+		else if constexpr (Traits::Type == EPropertyBagPropertyType::SoftClass)
+		{
+			return T(At<TSoftClassPtr<UObject>>(Index).ToSoftObjectPath());
+		}
+		else
+		{
+			static_assert(sizeof(T) == 0, "FKzDatabaseValueColumn::Get<T>: unsupported type");
+			return T{};
+		}
+	}
+
+private:
+	/** Replaces the column with NumItems default values of Type. Returns false if nothing was allocated. */
+	bool Allocate(const FKzTypeDef& Type, int32 NumItems);
+
+	/** Shared by the CopyTo overloads, both variants expose their value through GetData in the same representation. */
+	template <typename VariantType>
+	void CopyToVariant(int32 Index, VariantType& OutValue) const;
+
+	template <typename ElementType>
+	const ElementType& At(int32 Index) const
+	{
+		return *reinterpret_cast<const ElementType*>(Data + Index * Stride);
+	}
+
+	/** Column element type: the FKzVariant slot type, except Float which is stored as float. Struct columns use TypeObject. */
+	EPropertyBagPropertyType ValueType = EPropertyBagPropertyType::None;
+	const UObject* TypeObject = nullptr;
+
+	uint8* Data = nullptr;
+	int32 Stride = 0;
+	int32 Num = 0;
+
+	/** Number of items the column was built from, or INDEX_NONE when it needs a rebuild. */
+	int32 NumBuilt = INDEX_NONE;
+
+	/** Item revision of the owning database the column was built at. */
+	uint32 ItemRevision = 0;
+};
+
 /**
  * A container acting as a database registry.
  * It defines the Type for all its items.
@@ -118,13 +479,17 @@ struct KZLIB_API FKzDatabase
 	void InitType()
 	{
 		Type.Init<T>();
-		Items.Empty();
+		Empty();
 	}
 
 	/** Clears all items */
 	void Empty()
 	{
 		Items.Empty();
+		IdIndex.Reset();
+		NumIdIndexed = 0;
+		IdIndexRevision = ItemRevision;
+		MarkItemsChanged();
 	}
 
 	/** Returns true if there are no items */
@@ -133,12 +498,52 @@ struct KZLIB_API FKzDatabase
 		return Items.IsEmpty();
 	}
 
-	/** Removes an item by ID. Returns true if removed. */
-	bool RemoveItem(FName ID)
+	/**
+	 * Removes an item by ID. Returns true if removed.
+	 * Later items shift down, so the item order (and with it "first item wins" on query ties) is preserved.
+	 */
+	bool RemoveItem(FName ID);
+
+	/** Removes every item whose ID is listed, in a single pass that preserves the item order. Returns the number of items removed. */
+	int32 RemoveItems(TConstArrayView<FName> IDs);
+
+	/**
+	 * Adds or updates many items at once, matched by ID (e.g. when importing a table).
+	 * Items whose value does not match the database Type are skipped.
+	 * @return Number of items added or updated.
+	 */
+	int32 AddOrUpdateItems(TConstArrayView<FKzDatabaseItem> NewItems);
+
+	/** Returns the item with this ID, appending an empty one if there is none. Bumps the item revision, the caller may edit the item. */
+	FKzDatabaseItem& FindOrAddItem(FName ID);
+
+	/**
+	 * Marks the ID and tag indices and the value column as stale so the next lookup rebuilds them.
+	 * The mutators of this struct (and the mutable FindItem) keep them up to date; code that edits Items,
+	 * their IDs or their Tags directly must call it.
+	 */
+	void InvalidateIndex() const
+	{
+		MarkItemsChanged(true);
+	}
+
+	/** Marks only the value column as stale, for code that edited item values in place. */
+	void InvalidateValues() const
 	{
-		return Items.RemoveAll([&ID](const FKzDatabaseItem& Item) { return Item.ID == ID; }) > 0;
+		ValueColumn.Invalidate();
 	}
 
+	/** Rebuilds the transient indices once the items have been loaded. */
+	void PostSerialize(const FArchive& Ar);
+
+	/**
+	 * Compact binary form of Items, used by cooked assets instead of tagged property serialization:
+	 * a header, the ID table, the tag table with packed per-item bitsets, and the value column
+	 * (a single block for numeric types). Loading adopts the bitsets and column as the built
+	 * indices and rebuilds Items from them. Type is not included and must be serialized first.
+	 */
+	void SerializePacked(FArchive& Ar);
+
 	/**
 	 * Adds or Updates an item with type safety checks.
 	 * Returns nullptr if the provided type T does not match the Database Definition.
@@ -185,13 +590,7 @@ struct KZLIB_API FKzDatabase
 		}
 
 		// Perform Operation
-		FKzDatabaseItem* Item = FindItem(ID);
-
-		if (!Item)
-		{
-			Item = &Items.AddDefaulted_GetRef();
-			Item->ID = ID;
-		}
+		FKzDatabaseItem* Item = &FindOrAddItem(ID);
 
 		Item->Tags = Tags;
 		Item->SyncType(Type);
@@ -200,20 +599,66 @@ struct KZLIB_API FKzDatabase
 		return Item;
 	}
 
-	/** Finds an item by ID */
+	/** Finds an item by ID, in O(1) through the ID index. */
 	const FKzDatabaseItem* FindItem(FName ID) const;
+
+	/** As above, for editing the item's tags or value: bumps the item revision. Changing its ID requires InvalidateIndex. */
 	FKzDatabaseItem* FindItem(FName ID);
 
+	/** Returns the position of the item with this ID in Items, or INDEX_NONE. */
+	int32 FindItemIndex(FName ID) const;
+
+	/**
+	 * Bumped by every write path (mutators, the mutable FindItem, InvalidateIndex). Data derived from
+	 * the items is only valid for the revision it was built at.
+	 */
+	uint32 GetItemRevision() const
+	{
+		return ItemRevision;
+	}
+
+	/** Returns the position of Item in Items, or INDEX_NONE if it belongs to another database. */
+	int32 GetItemIndex(const FKzDatabaseItem* Item) const
+	{
+		const int32 Index = Item ? int32(Item - Items.GetData()) : INDEX_NONE;
+		return Items.IsValidIndex(Index) ? Index : INDEX_NONE;
+	}
+
+	/**
+	 * Typed read of the value of the item at ItemIndex through the value column
+	 * (contiguous and already in native form, unlike FKzDatabaseItem::GetValue).
+	 */
+	template <typename T>
+	T GetValueAt(int32 ItemIndex) const
+	{
+		BuildValueColumn();
+		return ValueColumn.Get<T>(ItemIndex);
+	}
+
+	/** Typed read of an item's value by ID. Returns false if there is no such item. */
+	template <typename T>
+	bool GetValue(FName ID, T& OutValue) const
+	{
+		const int32 Index = FindItemIndex(ID);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		OutValue = GetValueAt<T>(Index);
+		return true;
+	}
+
 	/**
 	 * Finds all items matching the query.
-	 * Results are sorted by Score (OptionalTags match count) descending.
+	 * Results are sorted by Score (OptionalTags match count) descending, ties keep the item order.
+	 * Tag constraints are resolved through the tag index; TagQuery runs as a compiled program (see FKzDatabaseTagProgram) over the remaining candidates only.
 	 * @return Number of items found.
 	 */
 	int32 QueryItems(const FKzDatabaseQuery& Query, TArray<const FKzDatabaseItem*>& OutItems) const;
 
 	/**
-	 * Finds the single best match for the query (highest score).
-	 * O(N) complexity and 0 heap allocations. Faster than QueryItems for single lookups.
+	 * Finds the single best match for the query (highest score, first item on ties).
+	 * Cost is proportional to the posting lists involved rather than the item count. Faster than QueryItems for single lookups.
 	 */
 	const FKzDatabaseItem* FindBestMatch(const FKzDatabaseQuery& Query) const;
 
@@ -227,9 +672,131 @@ struct KZLIB_API FKzDatabase
 		if (const FKzDatabaseItem* BestItem = FindBestMatch(Query))
 		{
 			OutID = BestItem->ID;
-			OutValue = BestItem->GetValue<T>();
+			OutValue = GetValueAt<T>(GetItemIndex(BestItem));
 			return true;
 		}
 		return false;
 	}
+
+	/**
+	 * Builds the ID and tag indices and the value column now if they are stale, instead of on first use.
+	 * The lazy rebuilds are not synchronized: call it before querying from several threads.
+	 */
+	void BuildIndex() const
+	{
+		if (!IsIdIndexUpToDate())
+		{
+			RebuildIdIndex();
+		}
+		BuildTagIndex();
+		BuildValueColumn();
+	}
+
+	/**
+	 * Lowers Query to bit masks over this database's tags, building the index if needed. TagQuery programs are cached per query.
+	 * The result stays valid until the database is modified.
+	 */
+	FKzDatabaseCompiledQuery CompileQuery(const FKzDatabaseQuery& Query) const;
+
+	/**
+	 * Finds the K best matches (highest score first, ties in item order, as QueryItems)
+	 * without sorting every match: a bounded heap keeps only the current best K.
+	 * @return Number of items found (at most K).
+	 */
+	int32 QueryTopK(const FKzDatabaseQuery& Query, int32 K, TArray<const FKzDatabaseItem*>& OutItems) const;
+
+	/**
+	 * Streams the items matching the query, in item order, with their OptionalTags score.
+	 * Results are neither collected nor sorted; return false from the visitor to stop early.
+	 */
+	void ForEachMatch(const FKzDatabaseQuery& Query, TFunctionRef<bool(const FKzDatabaseItem& Item, int32 Score)> Visitor) const;
+
+	/**
+	 * Picks a random item among the K best matches, with probability proportional to Weight.
+	 * With K <= 0 every match is a candidate and the pick is streamed without materialising them.
+	 * @return The picked item, or nullptr if nothing matched (or every weight was zero).
+	 */
+	const FKzDatabaseItem* PickWeightedRandom(const FKzDatabaseQuery& Query, int32 K, const FRandomStream& Stream, TFunctionRef<float(const FKzDatabaseItem& Item, int32 Score)> Weight) const;
+
+	/** As above, weighting each candidate by its score plus one. */
+	const FKzDatabaseItem* PickWeightedRandom(const FKzDatabaseQuery& Query, int32 K, const FRandomStream& Stream) const;
+
+	/**
+	 * Resolves many queries in a single pass over the items: OutBest[i] receives FindBestMatch(Queries[i]).
+	 * Every query is evaluated per item while it is hot in cache, and large batches are split across workers.
+	 * The tag index is built before the workers start; results are identical to calling FindBestMatch per query.
+	 */
+	void QueryBatch(TConstArrayView<FKzDatabaseQuery> Queries, TArrayView<const FKzDatabaseItem*> OutBest) const;
+
+private:
+	void BuildTagIndex() const
+	{
+		if (!TagIndex.IsUpToDate(Items, ItemRevision))
+		{
+			TagIndex.Build(Items, ItemRevision);
+		}
+	}
+
+	void BuildValueColumn() const
+	{
+		if (!ValueColumn.IsUpToDate(Type, Items, ItemRevision))
+		{
+			ValueColumn.Build(Type, Items, ItemRevision);
+		}
+	}
+
+	/**
+	 * Bumps the item revision, dropping the data derived from item tags and values. The ID index is
+	 * patched in place by the mutators, so it stays current unless IDs may have changed.
+	 */
+	void MarkItemsChanged(bool bIDsChanged = false) const
+	{
+		const bool bKeepIdIndex = !bIDsChanged && IsIdIndexUpToDate();
+		++ItemRevision;
+		if (bKeepIdIndex)
+		{
+			IdIndexRevision = ItemRevision;
+		}
+	}
+
+	/** The item count also catches direct edits of Items that skipped InvalidateIndex. */
+	bool IsIdIndexUpToDate() const
+	{
+		return IdIndexRevision == ItemRevision && NumIdIndexed == Items.Num();
+	}
+
+	/** Removes the item at Index, shifting the ID index entries of the items after it. */
+	void RemoveItemAt(int32 Index);
+
+	void RebuildIdIndex() const;
+
+	/** See GetItemRevision. */
+	mutable uint32 ItemRevision = 0;
+
+	/** ID -> position in Items, lazily rebuilt when stale and patched in place by the mutators. */
+	mutable TMap<FName, int32> IdIndex;
+
+	/** Number of items IdIndex was built from, or INDEX_NONE when it needs a rebuild. */
+	mutable int32 NumIdIndexed = INDEX_NONE;
+
+	/** Item revision IdIndex is current for. */
+	mutable uint32 IdIndexRevision = 0;
+
+	/** Lazily (re)built on the first indexed query after a change. Not thread-safe while stale. */
+	mutable FKzDatabaseTagIndex TagIndex;
+
+	/** Lazily (re)built on the first typed read after a change. */
+	mutable FKzDatabaseValueColumn ValueColumn;
+
+	/** TagQuery programs compiled against TagIndex. */
+	mutable FKzDatabaseTagProgramCache TagPrograms;
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzDatabase> : public TStructOpsTypeTraitsBase2<FKzDatabase>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
\ No newline at end of file
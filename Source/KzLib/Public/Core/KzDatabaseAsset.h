@@ -4,9 +4,32 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
 #include "Core/KzDatabase.h"
 #include "KzDatabaseAsset.generated.h"
 
+/** Hit and miss counters of a UKzDatabaseAsset query cache. */
+struct FKzDatabaseQueryCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+
+	double GetHitRate() const
+	{
+		const uint64 Total = Hits + Misses;
+		return Total > 0 ? double(Hits) / double(Total) : 0.0;
+	}
+};
+
+/** A cached ResolveMatch result, held as a position rather than a pointer so it never dangles. */
+struct FKzDatabaseQueryCacheEntry
+{
+	/** Database of the chain (flattened table included) holding the match, or null if nothing matched. */
+	const FKzDatabase* Database = nullptr;
+	int32 ItemIndex = INDEX_NONE;
+};
+
 /**
  * A Data Asset that wraps an FKzDatabase, providing heuristic scoring and hierarchical inheritance.
  * Only contains items of a single specific type defined by the internal Database schema.
@@ -29,6 +52,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Database", meta = (HideItems))
 	FKzDatabase Database;
 
+	/**
+	 * The items of this asset and every parent merged into one table, local items first so they keep winning ties.
+	 * Built when cooking (or on demand with Flatten) and used by ResolveMatch instead of walking the chain while up to date.
+	 */
+	UPROPERTY()
+	FKzDatabase FlattenedDatabase;
+
 	/**
 	 * Returns the parameter definition (Type) of the data stored in this asset.
 	 * Used by container components to route queries efficiently in O(1).
@@ -38,8 +68,13 @@ public:
 		return Database.Type;
 	}
 
+	/** Maximum number of query results remembered by ResolveMatch. */
+	static constexpr int32 QueryCacheSize = 64;
+
 	/**
 	 * Finds the best matching item for the given query, considering heuristic scoring and the parent hierarchy.
+	 * The last QueryCacheSize distinct queries are cached until this asset or one of its parents changes,
+	 * including edits through the FKzDatabase mutators. Safe to call from several threads once the indices are built.
 	 * @param Query The query containing required, ignored, and optional tags.
 	 * @return A pointer to the best matching item, or nullptr if no match was found.
 	 */
@@ -52,23 +87,87 @@ public:
 	template <typename T>
 	bool ResolveMatch(const FKzDatabaseQuery& Query, T& OutValue) const
 	{
-		if (const FKzDatabaseItem* BestItem = ResolveMatch(Query))
+		// Read through the value column of whichever database of the chain holds the item.
+		const FKzDatabaseQueryCacheEntry Match = ResolveMatchEntry(Query);
+		if (Match.Database)
 		{
-			OutValue = BestItem->GetValue<T>();
+			OutValue = Match.Database->GetValueAt<T>(Match.ItemIndex);
 			return true;
 		}
 		return false;
 	}
 
+	/**
+	 * Returns a stamp that changes whenever this asset or any asset in its parent chain is edited.
+	 * Cached results are valid as long as the stamp they were computed under is current.
+	 */
+	uint32 GetChainVersion() const;
+
+	/**
+	 * Bumps the version of this asset, dropping cached results here and in every child asset.
+	 * Editor changes call it automatically and the FKzDatabase mutators are tracked by the cache on their own;
+	 * call it after changing ParentDatabase or editing Database.Items directly from code.
+	 */
+	void NotifyDatabaseChanged();
+
+	/** Rebuilds FlattenedDatabase from the current parent chain. Done automatically when cooking. */
+	UFUNCTION(CallInEditor, Category = "Database")
+	void Flatten();
+
+	/**
+	 * Returns true if FlattenedDatabase exists and no asset of the chain changed since it was built,
+	 * neither through the editor (asset version) nor through the FKzDatabase mutators (item revisions).
+	 */
+	bool IsFlattenedUpToDate() const;
+
+	/** Hit and miss counts of the ResolveMatch cache. */
+	FKzDatabaseQueryCacheStats GetQueryCacheStats() const;
+	void ResetQueryCacheStats() const;
+
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
 protected:
+	/** Returns the database of this chain (flattened table included) whose Items hold Item. */
+	const FKzDatabase* FindOwningDatabase(const FKzDatabaseItem* Item) const;
+
 	/** Internal recursive function to find the best match and its score. */
 	const FKzDatabaseItem* ResolveBestMatchRecursive(const FKzDatabaseQuery& Query, int32& OutBestScore) const;
 
+	/** ResolveMatch through the query cache, returning where the match lives. */
+	FKzDatabaseQueryCacheEntry ResolveMatchEntry(const FKzDatabaseQuery& Query) const;
+
+	/** GetChainVersion combined with the item revision of every database of the chain. */
+	uint32 GetQueryCacheStamp() const;
+
+	/** Stamps FlattenedDatabase with the current chain version and item revisions. */
+	void RecordFlattenedState();
+
 private:
+	/** Set when FlattenedDatabase holds a merged table. Only ever saved as true in cooked data. */
+	UPROPERTY()
+	bool bFlattened = false;
+
+	/** Chain version FlattenedDatabase was built from. */
+	uint32 FlattenedVersion = 0;
+
+	/** Item revision of every Database of the chain when FlattenedDatabase was built, in chain order. */
+	TArray<uint32> FlattenedItemRevisions;
+
+	/** Taken from a global counter on every change, so the largest version along a chain identifies its state. */
+	uint32 Version = 0;
+
+	/** Query -> resolved item, valid for QueryCacheStamp. Finding an entry reorders the cache, so every access takes QueryCacheLock. */
+	mutable TLruCache<FKzDatabaseQuery, FKzDatabaseQueryCacheEntry> QueryCache{ QueryCacheSize };
+	mutable uint32 QueryCacheStamp = 0;
+	mutable FKzDatabaseQueryCacheStats QueryCacheStats;
+	mutable FCriticalSection QueryCacheLock;
+
 #if WITH_EDITOR
 	/** Checks if assigning the given parent would create a circular dependency loop. */
 	bool HasCircularDependency(const UKzDatabaseAsset* PotentialParent) const;
@@ -0,0 +1,146 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/KzDatabaseAsset.h"
+#include "UObject/ObjectKey.h"
+#include "KzDatabaseResolverSubsystem.generated.h"
+
+class AActor;
+class UKzDatabaseComponent;
+
+/**
+ * Resolution state shared by every database component that assigns the same database assets.
+ * Owned by UKzDatabaseResolverSubsystem; the address stays valid while any component uses it.
+ */
+struct KZLIB_API FKzDatabaseContext
+{
+	/** The registered asset set, in component order (nulls and untyped assets dropped). */
+	TArray<TObjectPtr<UKzDatabaseAsset>> Assets;
+
+	/** Assets indexed by interned type ID (see FKzTypeDef::GetTypeId); null for types without a database. */
+	TArray<TObjectPtr<UKzDatabaseAsset>> DispatchTable;
+
+	/** Hash of Assets, used to find identical sets. */
+	uint32 Hash = 0;
+
+	/** Number of registered components using this context. */
+	int32 NumUsers = 0;
+
+	/** Returns the asset resolving an interned type ID, if any. */
+	UKzDatabaseAsset* GetDatabaseAsset(int32 TypeId) const
+	{
+		return DispatchTable.IsValidIndex(TypeId) ? DispatchTable[TypeId].Get() : nullptr;
+	}
+
+	/** Resolves a query against the asset for T. */
+	template <typename T>
+	bool Resolve(const FKzDatabaseQuery& Query, T& OutValue) const
+	{
+		const UKzDatabaseAsset* Asset = GetDatabaseAsset(FKzTypeDef::TypeIdOf<T>());
+		return Asset && Asset->ResolveMatch<T>(Query, OutValue);
+	}
+};
+
+/**
+ * World-level resolver for database components.
+ *
+ * Components register their Databases array on BeginPlay. Identical asset sets are deduplicated
+ * into one shared FKzDatabaseContext, so thousands of actors referencing the same assets share a
+ * single dispatch table instead of each building their own. Because actors in the same context
+ * always resolve to the same value, ResolveForActors groups the actors by context and resolves
+ * each query once per context rather than once per actor.
+ */
+UCLASS()
+class KZLIB_API UKzDatabaseResolverSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ UWorldSubsystem interface
+	virtual void Deinitialize() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	/** Registers the component's asset set and returns the shared context it maps to. Re-registering moves the component to its current set. */
+	const FKzDatabaseContext* RegisterComponent(UKzDatabaseComponent* Component);
+
+	/** Releases the component's context; the context is destroyed once no component uses it. */
+	void UnregisterComponent(UKzDatabaseComponent* Component);
+
+	/** Returns the context an actor's database component is registered with, if any. */
+	const FKzDatabaseContext* FindContext(const AActor* Actor) const;
+
+	/** Number of distinct asset sets currently registered. */
+	int32 GetNumContexts() const { return Contexts.Num(); }
+
+	/**
+	 * Resolves one query for many actors.
+	 * OutValues matches Actors index for index; entries are unset for actors without a registered
+	 * component or without a match. Each distinct context is resolved once.
+	 * @return The number of actors that resolved a value.
+	 */
+	template <typename T>
+	int32 ResolveForActors(const FKzDatabaseQuery& Query, TConstArrayView<const AActor*> Actors, TArray<TOptional<T>>& OutValues) const
+	{
+		TArray<int32> ContextIds;
+		GroupByContext(Actors, ContextIds);
+
+		OutValues.Reset(Actors.Num());
+		OutValues.SetNum(Actors.Num());
+
+		// One slot per context ID touched by this batch.
+		TMap<int32, TOptional<T>, TInlineSetAllocator<8>> Resolved;
+
+		int32 NumResolved = 0;
+		for (int32 Index = 0; Index < Actors.Num(); ++Index)
+		{
+			const int32 ContextId = ContextIds[Index];
+			if (ContextId == INDEX_NONE)
+			{
+				continue;
+			}
+
+			TOptional<T>* Value = Resolved.Find(ContextId);
+			if (!Value)
+			{
+				Value = &Resolved.Add(ContextId);
+
+				T Result;
+				if (Contexts[ContextId]->Resolve<T>(Query, Result))
+				{
+					*Value = MoveTemp(Result);
+				}
+			}
+
+			if (Value->IsSet())
+			{
+				OutValues[Index] = *Value;
+				++NumResolved;
+			}
+		}
+
+		return NumResolved;
+	}
+
+private:
+	/** Fills OutContextIds with the context ID of each actor, INDEX_NONE for unregistered actors. */
+	void GroupByContext(TConstArrayView<const AActor*> Actors, TArray<int32>& OutContextIds) const;
+
+	/** Drops one user from a context, destroying it when unused. */
+	void ReleaseContext(int32 ContextId);
+
+	/** Live contexts; IDs are stable sparse indices and contexts are heap-allocated so their addresses are too. */
+	TSparseArray<TUniquePtr<FKzDatabaseContext>> Contexts;
+
+	/** Context IDs bucketed by asset set hash. */
+	TMultiMap<uint32, int32> ContextsByHash;
+
+	/** Context ID of each registered component. */
+	TMap<TObjectKey<UKzDatabaseComponent>, int32> ComponentContexts;
+
+	/** Context ID of each actor owning a registered component (the last registered component wins). */
+	TMap<TObjectKey<AActor>, int32> ActorContexts;
+};
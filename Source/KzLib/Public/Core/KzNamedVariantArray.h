@@ -0,0 +1,109 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "Core/KzNamedVariant.h"
+#include "Core/KzParamDef.h"
+#include "KzNamedVariantArray.generated.h"
+
+/** One entry of a FKzNamedVariantArray. */
+USTRUCT(BlueprintType)
+struct KZLIB_API FKzNamedVariantArrayItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "KzNamedVariant")
+	FName Name = NAME_None;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "KzNamedVariant")
+	FKzVariant Value;
+
+	/** Quantisation used to replicate Value. Only meaningful on the sending side, the packed stream describes itself. */
+	UPROPERTY(NotReplicated)
+	FKzNetQuantization Quantization;
+
+	/** Name, then Value through FKzVariant::NetSerializePacked. */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzNamedVariantArrayItem> : public TStructOpsTypeTraitsBase2<FKzNamedVariantArrayItem>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Replicated set of named variants with delta serialization.
+ *
+ * Replaces a replicated TArray<FKzNamedVariant>: built on FFastArraySerializer, so only the entries
+ * whose value changed since the last acknowledged state are sent, each one bit-packed with the
+ * quantisation of its FKzParamDef. Setting an entry to the value it already holds does not mark it.
+ *
+ * Usage:
+ *   UPROPERTY(Replicated)
+ *   FKzNamedVariantArray Params;
+ *
+ *   Params.Set<float>(HealthDef, 87.5f);
+ */
+USTRUCT(BlueprintType)
+struct KZLIB_API FKzNamedVariantArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/** Sets the value of an entry, adding it if needed. Marks the entry dirty only if the value changed. */
+	void SetValue(FName Name, const FKzVariant& Value, const FKzNetQuantization& Quantization = FKzNetQuantization());
+
+	/** Sets the value of the entry named after Def, replicated with Def's quantisation. */
+	void SetValue(const FKzParamDef& Def, const FKzVariant& Value)
+	{
+		SetValue(Def.Name, Value, Def.NetQuantization);
+	}
+
+	template <typename T>
+	void Set(const FKzParamDef& Def, const T& Value)
+	{
+		SetValue(Def, FKzVariant::Make<T>(Value));
+	}
+
+	/** Removes an entry. Returns false if there was none. */
+	bool RemoveValue(FName Name);
+
+	/** Returns the value of an entry, or nullptr. */
+	const FKzVariant* FindValue(FName Name) const;
+
+	/** Replaces the whole set, marking only the entries that were added or changed and removing the others. */
+	void Assign(TConstArrayView<FKzNamedVariant> Variants, TConstArrayView<FKzParamDef> Defs = {});
+
+	/** Copies the entries out as named variants, in entry order. */
+	void ToNamedVariants(TArray<FKzNamedVariant>& OutVariants) const;
+
+	const TArray<FKzNamedVariantArrayItem>& GetItems() const
+	{
+		return Items;
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FKzNamedVariantArrayItem, FKzNamedVariantArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	int32 FindIndex(FName Name) const;
+
+	UPROPERTY(VisibleAnywhere, Category = "KzNamedVariant")
+	TArray<FKzNamedVariantArrayItem> Items;
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzNamedVariantArray> : public TStructOpsTypeTraitsBase2<FKzNamedVariantArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -6,6 +6,32 @@
 #include "Core/KzTypeDef.h"
 #include "KzParamDef.generated.h"
 
+/** How floating-point values of a parameter are quantised when replicated (see FKzVariant::NetSerializePacked). */
+UENUM(BlueprintType)
+enum class EKzNetQuantization : uint8
+{
+	/** Float values are sent as 32 bits, Double values as 64 bits. */
+	None,
+	/** Double values are sent as 32-bit floats. */
+	Float,
+	/** Values are rounded to a fixed number of decimals and sent as zig-zag varints. */
+	Fixed,
+};
+
+/** Replication policy of a parameter's value. Does not take part in the definition's type signature. */
+USTRUCT(BlueprintType)
+struct KZLIB_API FKzNetQuantization
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+	EKzNetQuantization Mode = EKzNetQuantization::None;
+
+	/** Decimals kept by Fixed quantisation: values are rounded to multiples of 10^-Decimals. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication", meta = (ClampMin = "0", ClampMax = "7", EditCondition = "Mode == EKzNetQuantization::Fixed"))
+	uint8 Decimals = 2;
+};
+
 /**
  * Defines a single parameter definition (Name + Type).
  * It does not hold the value itself, only the signature.
@@ -117,4 +143,8 @@ struct KZLIB_API FKzParamDef
 	/** Type signature. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Def")
 	FKzTypeDef Type;
+
+	/** How replicated values of this parameter are quantised. Ignored by comparisons and hashing. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Def", AdvancedDisplay)
+	FKzNetQuantization NetQuantization;
 };
\ No newline at end of file
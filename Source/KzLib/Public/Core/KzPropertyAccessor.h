@@ -0,0 +1,82 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/KzParamDef.h"
+#include "Core/KzVariant.h"
+
+/**
+ * Precompiled conversion between one FProperty and variants of one FKzTypeDef.
+ *
+ * FKzVariant::FromProperty / ToProperty / MatchesProperty work out the conversion from the property
+ * class on every call. An accessor resolves it once into the value offset and a pair of load/store
+ * functions, so copying a value is a direct load or store. Accessors are built on first use of a
+ * (property, type) pair and cached; returned pointers stay valid for the lifetime of the process.
+ * In the editor, reinstancing blueprints or user structs drops the cache, since their properties are
+ * recreated: accessors fetched before that must be fetched again.
+ *
+ * Usage:
+ *   TArray<const FKzPropertyAccessor*> Accessors;
+ *   FKzPropertyAccessor::GetForParams(Object->GetClass(), Params, Accessors);
+ *   FKzPropertyAccessor::ReadAll(Accessors, Object, Values);
+ */
+struct KZLIB_API FKzPropertyAccessor
+{
+	using FReadFunc = void (*)(const FKzPropertyAccessor& Accessor, const void* ValuePtr, void* Dest);
+	using FWriteFunc = void (*)(const FKzPropertyAccessor& Accessor, const void* Src, void* ValuePtr);
+
+	/** Returns the accessor for Property and TypeDef, building it on first use. nullptr if the types are incompatible. */
+	static const FKzPropertyAccessor* Get(const FProperty* Property, const FKzTypeDef& TypeDef);
+
+	/** Resolves one accessor per param, looking properties up by name in Struct. Unresolved params get nullptr. */
+	static void GetForParams(const UStruct* Struct, TConstArrayView<FKzParamDef> Params, TArray<const FKzPropertyAccessor*>& OutAccessors);
+
+	/** Reads the property of Container (the object or struct instance owning it) into Value, reusing Value's storage when possible. */
+	void Read(const void* Container, FKzVariant& Value) const;
+
+	/** Writes Value into the property of Container. Returns false, leaving the property untouched, if Value doesn't fit it. */
+	bool Write(const FKzVariant& Value, void* Container) const;
+
+	/** Reads the property of each accessor into the variant at the same index. Null accessors are skipped. */
+	static void ReadAll(TConstArrayView<const FKzPropertyAccessor*> Accessors, const void* Container, TArrayView<FKzVariant> OutValues);
+
+	/** Writes each variant into the property of the accessor at the same index. Returns the number of values written. */
+	static int32 WriteAll(TConstArrayView<const FKzPropertyAccessor*> Accessors, TConstArrayView<FKzVariant> Values, void* Container);
+
+	const FProperty* GetProperty() const { return Property; }
+	const FKzTypeDef& GetTypeDef() const { return TypeDef; }
+
+private:
+	static TUniquePtr<FKzPropertyAccessor> Create(const FProperty* Property, const FKzTypeDef& TypeDef);
+
+	const FProperty* Property = nullptr;
+	FKzTypeDef TypeDef;
+
+	/** Type object read variants are seeded with, as FromProperty does: the struct, enum, or class of soft references. */
+	const UObject* TypeObject = nullptr;
+
+	int32 Offset = 0;
+	FReadFunc ReadFunc = nullptr;
+	FWriteFunc WriteFunc = nullptr;
+
+	/** How Write checks the type object of a variant (see FKzVariant::GetTypeObject) against the property. */
+	enum class ETypeObjectCheck : uint8
+	{
+		None,
+		/** Struct and enum: the same type object as TypeObject. */
+		Exact,
+		/** Object and class: a class derived from CheckClass, or none for null values. */
+		ValueDerived,
+		/** Soft object and soft class: a base of CheckClass, or none. */
+		PropertyDerived,
+	};
+
+	/** Property class (or meta class) class-typed values are checked against. */
+	const UClass* CheckClass = nullptr;
+
+	/** TypeObject is part of the variant's type, so a variant holding another one cannot be reused by Read. */
+	bool bFixedTypeObject = false;
+
+	ETypeObjectCheck TypeObjectCheck = ETypeObjectCheck::None;
+};
@@ -4,22 +4,199 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/Shapes/KzBox.h"
+#include "Spatial/KzSpatialRegistry.h"
 #include "KzRegistrySubsystem.generated.h"
 
-/** Helper struct to wrap the array so we can store it in a TMap */
-struct FKzObjectBucket
+/**
+ * Objects registered under one class.
+ *
+ * Objects are held weakly; destroyed ones are skipped by every lookup and physically removed by a
+ * lazy sweep that inspects a small batch of slots on every registration change and once per tick, so
+ * no single call pays for a full scan. Reads never sweep, so iterating a bucket never reorders it.
+ * An object -> slot index makes Add/Remove/Contains O(1).
+ */
+struct KZLIB_API FKzObjectBucket
 {
+	/** Number of slots inspected by each lazy sweep step. */
+	static constexpr int32 SweepBatchSize = 32;
+
 	/** We use Weak Pointers for safety. If an object is destroyed, it becomes stale automatically. */
 	TArray<TWeakObjectPtr<UObject>> Objects;
+
+	/** Object key of each entry of Objects, kept parallel to it. */
+	TArray<FObjectKey> Keys;
+
+	/** Object -> index in Objects. Object keys stay distinct after their objects die, unlike stale weak pointers. */
+	TMap<FObjectKey, int32> Indices;
+
+	/** Adds the object if not present. Returns false if it was already registered. */
+	bool Add(UObject* Object);
+
+	/** Removes the object if present. Returns false if it was not registered. */
+	bool Remove(UObject* Object);
+
+	bool Contains(const UObject* Object) const { return Indices.Contains(FObjectKey(Object)); }
+
+	/** Inspects up to Budget slots starting at the sweep cursor and drops stale entries, passing the key of each to OnRemoved. */
+	void Sweep(TFunctionRef<void(const FObjectKey&)> OnRemoved, int32 Budget = SweepBatchSize);
+
+	/** Calls Func(UObject*) for every live object. Never allocates. */
+	template <typename TFunc>
+	void ForEachLive(TFunc&& Func) const
+	{
+		for (const TWeakObjectPtr<UObject>& Weak : Objects)
+		{
+			if (UObject* Object = Weak.Get())
+			{
+				Func(Object);
+			}
+		}
+	}
+
+private:
+	void RemoveAtSwap(int32 Index);
+
+	int32 SweepCursor = 0;
+};
+
+/**
+ * Allocation-free range over the live items of one or more buckets, typed as T.
+ *
+ *   for (AMyActor* Actor : Registry->View<AMyActor>())
+ *
+ * Buckets are only read; the view must not outlive a registration change.
+ */
+template <typename T>
+class TKzRegistryView
+{
+public:
+	using FBucketList = TArray<const FKzObjectBucket*, TInlineAllocator<8>>;
+
+	explicit TKzRegistryView(FBucketList InBuckets)
+		: Buckets(MoveTemp(InBuckets))
+	{
+	}
+
+	struct FIterator
+	{
+		const FBucketList* Buckets;
+		int32 BucketIndex;
+		int32 ObjectIndex;
+		T* Current = nullptr;
+
+		T* operator*() const { return Current; }
+
+		FIterator& operator++()
+		{
+			++ObjectIndex;
+			Settle();
+			return *this;
+		}
+
+		bool operator!=(const FIterator& Other) const
+		{
+			return BucketIndex != Other.BucketIndex || ObjectIndex != Other.ObjectIndex;
+		}
+
+		/** Advances to the first live object at or after the current position. */
+		void Settle()
+		{
+			Current = nullptr;
+			for (; BucketIndex < Buckets->Num(); ++BucketIndex, ObjectIndex = 0)
+			{
+				const TArray<TWeakObjectPtr<UObject>>& Objects = (*Buckets)[BucketIndex]->Objects;
+				for (; ObjectIndex < Objects.Num(); ++ObjectIndex)
+				{
+					// Buckets only ever hold objects registered as T or one of its subclasses.
+					if (UObject* Object = Objects[ObjectIndex].Get())
+					{
+						Current = static_cast<T*>(Object);
+						return;
+					}
+				}
+			}
+			ObjectIndex = 0;
+		}
+	};
+
+	FIterator begin() const
+	{
+		FIterator It{ &Buckets, 0, 0 };
+		It.Settle();
+		return It;
+	}
+
+	FIterator end() const { return FIterator{ &Buckets, Buckets.Num(), 0 }; }
+
+	bool IsEmpty() const { return !(begin() != end()); }
+
+private:
+	FBucketList Buckets;
+};
+
+/** Cached placement of an object inside a spatially indexed bucket. */
+struct FKzSpatialItem
+{
+	TWeakObjectPtr<UObject> Object;
+	FBox Bounds = FBox(ForceInitToZero);
+	bool bDynamic = false;
+
+	/** Index in FKzSpatialBucket::DynamicItems, or INDEX_NONE for static items. */
+	int32 DynamicIndex = INDEX_NONE;
+};
+
+/** TSpatialRegistry semantics over spatial items, identified by their object. */
+struct FKzSpatialItemSemantics
+{
+	using ElementIdType = TWeakObjectPtr<UObject>;
+
+	static FBox GetBoundingBox(const FKzSpatialItem* Item) { return Item->Bounds; }
+	static ElementIdType GetElementId(const FKzSpatialItem* Item) { return Item->Object; }
+	static FVector GetElementPosition(const FKzSpatialItem* Item) { return Item->Bounds.GetCenter(); }
+	static FKzShapeInstance GetShape(const FKzSpatialItem* Item) { return FKzShapeInstance::Make<FKzBox>(Item->Bounds.GetExtent().ComponentMax(FVector(1.0))); }
+	static bool IsValid(const FKzSpatialItem* Item) { return Item != nullptr; }
+	static bool IsDynamic(const FKzSpatialItem* Item) { return Item->bDynamic; }
 };
 
-/** A central registry for any type of object in the world. */
+/**
+ * Spatial index mirroring one bucket (see UKzRegistrySubsystem::EnableSpatialIndex).
+ * Items own their cached bounds so the grids never dereference objects.
+ */
+struct FKzSpatialBucket
+{
+	Kz::TSpatialRegistry<const FKzSpatialItem*, FKzSpatialItemSemantics> Index;
+	TMap<FObjectKey, TUniquePtr<FKzSpatialItem>> Items;
+
+	/** Movable items, the only ones whose bounds are refreshed every tick. */
+	TArray<FKzSpatialItem*> DynamicItems;
+};
+
+/**
+ * A central registry for any type of object in the world.
+ *
+ * Items are registered under their static type T. Besides the exact-class lookups, every query can
+ * optionally include subclasses: a class-hierarchy index maps each class to the registered buckets
+ * of itself and its descendants, so GetItems<ABase>(true) does not scan unrelated buckets. An object
+ * registered under several classes of the same hierarchy is visited once per registration.
+ *
+ * Buckets of actors or scene components can opt into a spatial index (EnableSpatialIndex<T>()), which
+ * adds QueryItemsInShape<T>() and FindNearestItems<T>(). Movable items are re-indexed by a single
+ * per-world tick; everything else is indexed once.
+ */
 UCLASS()
-class KZLIB_API UKzRegistrySubsystem : public UWorldSubsystem
+class KZLIB_API UKzRegistrySubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	//~ UTickableWorldSubsystem interface
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
 	// --- Registration API ---
 
 	/** Registers an item under a specific category (Class). */
@@ -27,13 +204,13 @@ public:
 	void RegisterItem(T* Item)
 	{
 		if (!Item) return;
-		UClass* Key = T::StaticClass();
 
-		FKzObjectBucket& Bucket = RegistryMap.FindOrAdd(Key);
-		if (!Bucket.Objects.Contains(Item))
+		FKzObjectBucket& Bucket = FindOrAddBucket(T::StaticClass());
+		if (Bucket.Add(Item))
 		{
-			Bucket.Objects.Add(Item);
+			AddSpatialItem(T::StaticClass(), Item);
 		}
+		SweepBucket(T::StaticClass(), Bucket);
 	}
 
 	/** Unregisters an item. */
@@ -41,69 +218,153 @@ public:
 	void UnregisterItem(T* Item)
 	{
 		if (!Item) return;
-		UClass* Key = T::StaticClass();
 
-		if (FKzObjectBucket* Bucket = RegistryMap.Find(Key))
+		if (FKzObjectBucket* Bucket = FindBucket(T::StaticClass()))
 		{
-			Bucket->Objects.RemoveSwap(Item);
+			if (Bucket->Remove(Item))
+			{
+				RemoveSpatialItem(T::StaticClass(), FObjectKey(Item));
+			}
+			SweepBucket(T::StaticClass(), *Bucket);
 		}
 	}
 
+	/** Returns true if the item is registered under type T. O(1). */
+	template <typename T>
+	bool IsRegistered(const T* Item) const
+	{
+		const FKzObjectBucket* Bucket = Item ? FindBucket(T::StaticClass()) : nullptr;
+		return Bucket && Bucket->Contains(Item);
+	}
+
 	// --- Retrieval API ---
 
-	/** Returns items registered under type T. */
+	/**
+	 * Allocation-free view over the live items registered under type T
+	 * (and under its subclasses if bIncludeSubclasses).
+	 */
 	template <typename T>
-	TArray<T*> GetItems()
+	TKzRegistryView<T> View(bool bIncludeSubclasses = false) const
 	{
-		TArray<T*> Result;
-		UClass* Key = T::StaticClass();
+		typename TKzRegistryView<T>::FBucketList Buckets;
+		GatherBuckets(T::StaticClass(), bIncludeSubclasses, Buckets);
+		return TKzRegistryView<T>(MoveTemp(Buckets));
+	}
 
-		if (FKzObjectBucket* Bucket = RegistryMap.Find(Key))
+	/** Calls Func(T*) for every live item registered under type T (and its subclasses if bIncludeSubclasses). */
+	template <typename T, typename TFunc>
+	void ForEachItem(TFunc&& Func, bool bIncludeSubclasses = false) const
+	{
+		for (T* Item : View<T>(bIncludeSubclasses))
 		{
-			ProcessBucket<T>(*Bucket, Result);
+			Func(Item);
+		}
+	}
+
+	/** Returns items registered under type T (and its subclasses if bIncludeSubclasses). */
+	template <typename T>
+	TArray<T*> GetItems(bool bIncludeSubclasses = false) const
+	{
+		TArray<T*> Result;
+		for (T* Item : View<T>(bIncludeSubclasses))
+		{
+			Result.Add(Item);
 		}
 		return Result;
 	}
 
 	/** Looks up the bucket using 'RequestedClass', * but returns the objects cast to 'T'. */
 	template <typename T>
-	TArray<T*> GetItems(TSubclassOf<UObject> RequestedClass)
+	TArray<T*> GetItems(TSubclassOf<UObject> RequestedClass, bool bIncludeSubclasses = false) const
 	{
 		TArray<T*> Result;
 		if (!RequestedClass) return Result;
 
-		if (FKzObjectBucket* Bucket = RegistryMap.Find(RequestedClass))
+		TKzRegistryView<UObject>::FBucketList Buckets;
+		GatherBuckets(RequestedClass, bIncludeSubclasses, Buckets);
+		for (UObject* Object : TKzRegistryView<UObject>(MoveTemp(Buckets)))
 		{
-			ProcessBucket<T>(*Bucket, Result);
+			// Objects that exist but are not a T belong in the bucket, just not in this result.
+			if (T* CastedObj = Cast<T>(Object))
+			{
+				Result.Add(CastedObj);
+			}
 		}
 		return Result;
 	}
 
+	// --- Spatial API ---
+
+	/**
+	 * Opts the bucket of type T (an AActor or USceneComponent type) into spatial indexing.
+	 * Items already registered are indexed immediately. Only the exact bucket of T is indexed, not subclasses.
+	 * Actors are placed by their root component's bounds; movable items are refreshed every tick.
+	 *
+	 * @param CellSize  Hash grid cell size; roughly the typical query radius works well.
+	 */
+	template <typename T>
+	void EnableSpatialIndex(float CellSize = 1000.0f)
+	{
+		EnableSpatialIndex(T::StaticClass(), CellSize);
+	}
+
+	void EnableSpatialIndex(UClass* Class, float CellSize = 1000.0f);
+
+	/** Returns the items of a spatially indexed type T whose bounds overlap the shape. */
+	template <typename T>
+	TArray<T*> QueryItemsInShape(const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation = FQuat::Identity) const
+	{
+		TArray<TWeakObjectPtr<UObject>> Found;
+		QueryObjectsInShape(T::StaticClass(), Found, Shape, Position, Rotation);
+		return ResolveItems<T>(Found);
+	}
+
+	/** Returns up to K items of a spatially indexed type T, nearest (to their bounds) first. */
+	template <typename T>
+	TArray<T*> FindNearestItems(const FVector& Point, int32 K, float MaxDistance = UE_BIG_NUMBER) const
+	{
+		TArray<TWeakObjectPtr<UObject>> Found;
+		FindNearestObjects(T::StaticClass(), Found, Point, K, MaxDistance);
+		return ResolveItems<T>(Found);
+	}
+
 private:
-	/** Iterates the bucket, removes stale objects, and casts valid ones to T. */
+	FKzObjectBucket* FindBucket(const UClass* Class) const;
+	FKzObjectBucket& FindOrAddBucket(UClass* Class);
+
+	/** Advances the lazy sweep of the bucket of Class, dropping the spatial items of the destroyed objects it removes. */
+	void SweepBucket(const UClass* Class, FKzObjectBucket& Bucket);
+
+	/** Collects the bucket of Class (and of its registered subclasses). */
+	void GatherBuckets(const UClass* Class, bool bIncludeSubclasses, TArray<const FKzObjectBucket*, TInlineAllocator<8>>& OutBuckets) const;
+
+	/** Buckets are heap-allocated so the hierarchy index can point at them across map growth. */
+	TMap<const UClass*, TUniquePtr<FKzObjectBucket>> RegistryMap;
+
+	/** Class -> buckets registered for that class or any of its subclasses. */
+	TMap<const UClass*, TArray<FKzObjectBucket*, TInlineAllocator<4>>> HierarchyIndex;
+
+	/** Spatial indices of the buckets that opted in. */
+	TMap<const UClass*, TUniquePtr<FKzSpatialBucket>> SpatialBuckets;
+
+	void AddSpatialItem(const UClass* Class, UObject* Object);
+	void RemoveSpatialItem(const UClass* Class, const FObjectKey& Key);
+
+	void QueryObjectsInShape(const UClass* Class, TArray<TWeakObjectPtr<UObject>>& OutObjects, const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation) const;
+	void FindNearestObjects(const UClass* Class, TArray<TWeakObjectPtr<UObject>>& OutObjects, const FVector& Point, int32 K, float MaxDistance) const;
+
 	template <typename T>
-	void ProcessBucket(FKzObjectBucket& Bucket, TArray<T*>& OutResult)
+	static TArray<T*> ResolveItems(const TArray<TWeakObjectPtr<UObject>>& Objects)
 	{
-		for (int32 i = 0; i < Bucket.Objects.Num(); ++i)
+		TArray<T*> Result;
+		Result.Reserve(Objects.Num());
+		for (const TWeakObjectPtr<UObject>& Object : Objects)
 		{
-			if (UObject* Obj = Bucket.Objects[i].Get())
+			if (UObject* Resolved = Object.Get())
 			{
-				// Valid object, attempt cast to T
-				if (T* CastedObj = Cast<T>(Obj))
-				{
-					OutResult.Add(CastedObj);
-				}
-				// Note: If object exists but cast fails, we simply skip it.
-				// We don't remove it because it belongs in this bucket, just isn't the type T we asked for now.
-			}
-			else
-			{
-				// Object was destroyed (GC'd), remove from registry
-				Bucket.Objects.RemoveAtSwap(i);
-				--i;
+				Result.Add(static_cast<T*>(Resolved));
 			}
 		}
+		return Result;
 	}
-
-	TMap<UClass*, FKzObjectBucket> RegistryMap;
-};
\ No newline at end of file
+};
@@ -61,6 +61,23 @@ struct KZLIB_API FKzTypeDef
 	/** True if a property declared as this type would accept the given FProperty. */
 	bool MatchesProperty(const FProperty* Property) const;
 
+	/**
+	 * Process-wide interned ID of this type, assigned once per distinct type and dense from 0.
+	 * Lets hot paths dispatch on a type with an array index instead of hashing the full definition.
+	 */
+	int32 GetTypeId() const;
+
+	/** As GetTypeId, but returns INDEX_NONE instead of interning a type that was never seen. */
+	int32 FindTypeId() const;
+
+	/** Interned ID of the type of T, computed once per T. */
+	template <typename T>
+	static int32 TypeIdOf()
+	{
+		static const int32 TypeId = Make<T>().GetTypeId();
+		return TypeId;
+	}
+
 	/** Initializes the type information based on T. */
 	template <typename T>
 	void Init()
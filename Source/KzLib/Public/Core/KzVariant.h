@@ -9,6 +9,8 @@
 #include "StructUtils/PropertyBag.h"
 #include "KzVariant.generated.h"
 
+struct FKzNetQuantization;
+
 /**
  * A type-erased value that can hold any property type supported by the KzLib param system.
  * Uses multi-slot storage so serialization, GC, replication and undo/redo work natively.
@@ -59,7 +61,7 @@ public:
 	template <typename T>
 	static FKzVariant Make(const T& Value);
 
-	/** Reads a value from a raw FProperty + memory pair into a fresh variant. */
+	/** Reads a value from a raw FProperty + memory pair into a fresh variant. For repeated copies of the same property, use FKzPropertyAccessor. */
 	static FKzVariant FromProperty(const FProperty* Property, const void* ValuePtr);
 
 	/** Writes the held value into a raw FProperty + memory pair, if the types match. Returns true on success. */
@@ -75,7 +77,17 @@ public:
 	void* GetData();
 	const void* GetData() const;
 
+	/** Replicates the value with NetSerializePacked and no quantisation. */
 	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/**
+	 * Bandwidth-optimised replication: the type in 5 bits, bools in 1 bit, integers and enum values as
+	 * zig-zag varints, and Float / Double values quantised per Quantization (typically the owning
+	 * FKzParamDef::NetQuantization). The quantisation mode travels with the value, so the receiving side
+	 * needs no schema to decode it.
+	 */
+	bool NetSerializePacked(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess, const FKzNetQuantization& Quantization);
+
 	bool operator==(const FKzVariant& Other) const;
 	bool operator!=(const FKzVariant& Other) const { return !(*this == Other); }
 
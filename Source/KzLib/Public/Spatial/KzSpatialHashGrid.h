@@ -93,6 +93,16 @@ namespace Kz
 		template <typename TValidator = FDefaultValidator>
 		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator = {}) const;
 
+		/**
+		 * Invokes Func once for every valid element whose bounds intersect the given box.
+		 * Lower-level than Query(): callers receive the elements themselves (e.g. to rank them by distance).
+		 *
+		 * @param Bounds  The box to visit.
+		 * @param Func    Callable: void(const ElementType&).
+		 */
+		template <typename TFunc>
+		void ForEachInBounds(const FBox& Bounds, TFunc&& Func) const;
+
 		/**
 		 * Draws a debug visualization.
 		 *
@@ -351,6 +351,42 @@ namespace Kz
 		return !OutResults.IsEmpty();
 	}
 
+	template <typename ElementType, typename GridSemantics>
+	template <typename TFunc>
+	void TSpatialHashGrid<ElementType, GridSemantics>::ForEachInBounds(const FBox& Bounds, TFunc&& Func) const
+	{
+		TSet<ElementIdType> Visited;
+
+		const FInt64Vector Min = GetCellCoord(Bounds.Min, CellSize);
+		const FInt64Vector Max = GetCellCoord(Bounds.Max, CellSize);
+
+		for (int64 x = Min.X; x <= Max.X; ++x)
+		{
+			for (int64 y = Min.Y; y <= Max.Y; ++y)
+			{
+				for (int64 z = Min.Z; z <= Max.Z; ++z)
+				{
+					const TArray<ElementType>* Cell = GridCells.Find(GetCellKey(x, y, z));
+					if (!Cell)
+						continue;
+
+					for (const ElementType& E : *Cell)
+					{
+						bool bAlreadyVisited = false;
+						Visited.Add(GridSemantics::GetElementId(E), &bAlreadyVisited);
+						if (bAlreadyVisited || !GridSemantics::IsValid(E))
+							continue;
+
+						if (Bounds.Intersect(GridSemantics::GetBoundingBox(E)))
+						{
+							Func(E);
+						}
+					}
+				}
+			}
+		}
+	}
+
 	template <typename ElementType, typename GridSemantics>
 	void TSpatialHashGrid<ElementType, GridSemantics>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 	{
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Spatial/KzSpatialHashGrid.h"
+#include "Collision/KzHitResult.h"
 
 namespace Kz
 {
@@ -14,15 +15,21 @@ namespace Kz
 	 *
 	 * TSemantics must satisfy TSpatialHashGrid's contract plus one extra static method:
 	 *   static bool IsDynamic(const TElement&);
+	 *
+	 * Owners that already know which elements moved can skip the TickDynamics() scan and call
+	 * Update() for just those elements instead.
 	 */
 	template<typename TElement, typename TSemantics>
 	class TSpatialRegistry
 	{
 	public:
+		using ElementIdType = typename TSemantics::ElementIdType;
+
 		void SetCellSize(float InCellSize)
 		{
-			StaticGrid.SetCellSize(InCellSize);
-			DynamicGrid.SetCellSize(InCellSize);
+			CellSize = FMath::Max(1.0f, InCellSize);
+			StaticGrid.SetCellSize(CellSize);
+			DynamicGrid.SetCellSize(CellSize);
 		}
 
 		/**
@@ -43,6 +50,7 @@ namespace Kz
 			DynamicGrid.Reset();
 			Registered.Reset();
 			DynamicTracks.Reset();
+			DynamicTrackIndices.Reset();
 		}
 
 		void Register(const TElement& Element)
@@ -56,7 +64,7 @@ namespace Kz
 
 			if (TSemantics::IsDynamic(Element))
 			{
-				DynamicTracks.Add(FDynamicTrack{ Element, TSemantics::GetBoundingBox(Element) });
+				DynamicTrackIndices.Add(Element, DynamicTracks.Add(FDynamicTrack{ Element, TSemantics::GetBoundingBox(Element) }));
 				DynamicGrid.Insert(Element);
 			}
 			else
@@ -76,11 +84,10 @@ namespace Kz
 
 			if (TSemantics::IsDynamic(Element))
 			{
-				const int32 Index = DynamicTracks.IndexOfByPredicate([&Element](const FDynamicTrack& Track) { return Track.Element == Element; });
-				if (Index != INDEX_NONE)
+				if (const int32* Index = DynamicTrackIndices.Find(Element))
 				{
-					DynamicGrid.Remove(Element, DynamicTracks[Index].LastBounds);
-					DynamicTracks.RemoveAtSwap(Index);
+					DynamicGrid.Remove(Element, DynamicTracks[*Index].LastBounds);
+					RemoveDynamicTrack(*Index);
 				}
 			}
 			else
@@ -89,12 +96,137 @@ namespace Kz
 			}
 		}
 
-		void Query(TArray<typename TSemantics::ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation) const
+		/**
+		 * Re-indexes a single registered dynamic element if its bounds moved past the reindex threshold.
+		 * Equivalent to what TickDynamics() does for every element, for owners that track changes themselves.
+		 */
+		void Update(const TElement& Element)
+		{
+			const int32* Index = DynamicTrackIndices.Find(Element);
+			if (!Index)
+			{
+				return;
+			}
+
+			FDynamicTrack& Track = DynamicTracks[*Index];
+			const FBox CurrentBounds = TSemantics::GetBoundingBox(Element);
+			if (!CurrentBounds.Equals(Track.LastBounds, ReindexThreshold))
+			{
+				DynamicGrid.Remove(Track.Element, Track.LastBounds);
+				Track.LastBounds = CurrentBounds;
+				DynamicGrid.Insert(Track.Element);
+			}
+		}
+
+		void Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation) const
 		{
 			StaticGrid.Query(OutResults, Shape, Position, Rotation);
 			DynamicGrid.Query(OutResults, Shape, Position, Rotation);
 		}
 
+		/**
+		 * Raycasts both grids and returns the closest hit.
+		 * @param RayLength  Ray length. <= 0 means infinite.
+		 */
+		bool Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength) const
+		{
+			const bool bStaticHit = StaticGrid.Raycast(OutId, OutHit, RayStart, RayDir, RayLength);
+
+			// The dynamic pass only needs to beat the static hit, if any.
+			ElementIdType DynamicId = OutId;
+			FKzHitResult DynamicHit;
+			const float DynamicLength = bStaticHit ? FMath::Max(OutHit.Distance, UE_KINDA_SMALL_NUMBER) : RayLength;
+			if (DynamicGrid.Raycast(DynamicId, DynamicHit, RayStart, RayDir, DynamicLength) && (!bStaticHit || DynamicHit.Distance < OutHit.Distance))
+			{
+				OutId = DynamicId;
+				OutHit = DynamicHit;
+				return true;
+			}
+
+			return bStaticHit;
+		}
+
+		/**
+		 * Finds the K elements closest to Point (distance to their bounds), nearest first.
+		 *
+		 * Searches an expanding box around the point, starting at one cell and doubling until K
+		 * candidates are confirmed within the searched radius or MaxDistance is reached. Walking a box
+		 * costs one cell lookup per cell, which grows with the cube of the radius, so once the box
+		 * would span more cells than there are registered elements the search switches to a linear
+		 * scan of every element. Dense neighbourhoods resolve in a few cells; sparse data, large K or
+		 * an unbounded MaxDistance cost at most one pass over the registered elements.
+		 */
+		void FindNearest(TArray<ElementIdType>& OutResults, const FVector& Point, int32 K, float MaxDistance = UE_BIG_NUMBER) const
+		{
+			if (K <= 0 || Registered.IsEmpty() || MaxDistance < 0.0f)
+			{
+				return;
+			}
+
+			struct FCandidate
+			{
+				ElementIdType Id;
+				double DistSq;
+			};
+			TArray<FCandidate> Candidates;
+
+			const auto Collect = [&Candidates, &Point](const TElement& Element)
+			{
+				Candidates.Add({ TSemantics::GetElementId(Element), TSemantics::GetBoundingBox(Element).ComputeSquaredDistanceToPoint(Point) });
+			};
+
+			// Doubling from one cell, this is enough to cover any radius a float can express.
+			constexpr int32 MaxSearchSteps = 32;
+
+			float Radius = FMath::Min(CellSize, MaxDistance);
+			bool bLinearScan = true;
+			for (int32 Step = 0; Step < MaxSearchSteps; ++Step)
+			{
+				// Counted in doubles: the cell count of a large box overflows any integer type.
+				const double CellsPerAxis = 2.0 * FMath::CeilToDouble(Radius / CellSize) + 1.0;
+				if (CellsPerAxis * CellsPerAxis * CellsPerAxis > (double)Registered.Num())
+				{
+					break;
+				}
+
+				Candidates.Reset();
+				const FBox SearchBox = FBox::BuildAABB(Point, FVector(Radius));
+				StaticGrid.ForEachInBounds(SearchBox, Collect);
+				DynamicGrid.ForEachInBounds(SearchBox, Collect);
+
+				Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+
+				// Anything outside the searched box is farther than Radius, so the first K found within Radius are final.
+				const bool bConfirmed = Candidates.Num() >= K && Candidates[K - 1].DistSq <= FMath::Square(Radius);
+				if (bConfirmed || Radius >= MaxDistance)
+				{
+					bLinearScan = false;
+					break;
+				}
+
+				Radius = FMath::Min(Radius * 2.0f, MaxDistance);
+			}
+
+			if (bLinearScan)
+			{
+				Candidates.Reset();
+				for (const TElement& Element : Registered)
+				{
+					if (TSemantics::IsValid(Element))
+					{
+						Collect(Element);
+					}
+				}
+				Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+			}
+
+			const double MaxDistSq = FMath::Square((double)MaxDistance);
+			for (int32 i = 0; i < Candidates.Num() && i < K && Candidates[i].DistSq <= MaxDistSq; ++i)
+			{
+				OutResults.Add(Candidates[i].Id);
+			}
+		}
+
 		void DebugDraw(const class UWorld* World, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const
 		{
 			StaticGrid.DebugDraw(World, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
@@ -109,7 +241,7 @@ namespace Kz
 
 				if (!TSemantics::IsValid(Track.Element))
 				{
-					DynamicTracks.RemoveAtSwap(i);
+					RemoveDynamicTrack(i);
 					continue;
 				}
 
@@ -136,6 +268,20 @@ namespace Kz
 		TSpatialHashGrid<TElement, TSemantics> DynamicGrid;
 		TSet<TElement> Registered;
 		TArray<FDynamicTrack> DynamicTracks;
+		TMap<TElement, int32> DynamicTrackIndices;
 		float ReindexThreshold = 10.0f;
+		float CellSize = 100.0f;
+
+		/** Swap-removes a track, keeping the element -> track index map in sync. */
+		void RemoveDynamicTrack(int32 Index)
+		{
+			DynamicTrackIndices.Remove(DynamicTracks[Index].Element);
+			DynamicTracks.RemoveAtSwap(Index);
+
+			if (DynamicTracks.IsValidIndex(Index))
+			{
+				DynamicTrackIndices.Add(DynamicTracks[Index].Element, Index);
+			}
+		}
 	};
 }
@@ -11,7 +11,8 @@ public class KzLibECS : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core"
+				"Core",
+				"KzLib"
 			}
 			);
 
@@ -19,8 +20,7 @@ public class KzLibECS : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
-				"Engine",
-				"KzLib"
+				"Engine"
 			}
 			);
 	}
@@ -0,0 +1,129 @@
+// Copyright 2026 kirzo
+
+#include "KzEcsSnapshot.h"
+
+namespace Kz::ECS
+{
+	namespace
+	{
+		/** Returns false if both blobs are identical, otherwise fills OutPatch with the pages of Current that differ from Base. */
+		bool DiffBlob(const TArray<uint8>& Base, const TArray<uint8>& Current, FRegistryDelta::FBlobPatch& OutPatch)
+		{
+			if (Base.Num() == Current.Num() && FMemory::Memcmp(Base.GetData(), Current.GetData(), Current.Num()) == 0)
+			{
+				return false;
+			}
+
+			constexpr int32 PageSize = FRegistryDelta::PageSize;
+
+			OutPatch.Size = Current.Num();
+			OutPatch.Pages.Reset();
+			OutPatch.Data.Reset();
+
+			const int32 NumPages = (Current.Num() + PageSize - 1) / PageSize;
+			for (int32 Page = 0; Page < NumPages; ++Page)
+			{
+				const int32 Offset = Page * PageSize;
+				const int32 Length = FMath::Min(PageSize, Current.Num() - Offset);
+
+				// Pages past the end of the base, or cut short by it, are always sent whole.
+				const bool bSame = Offset + Length <= Base.Num() && FMemory::Memcmp(Base.GetData() + Offset, Current.GetData() + Offset, Length) == 0;
+				if (!bSame)
+				{
+					OutPatch.Pages.Add(Page);
+					OutPatch.Data.Append(Current.GetData() + Offset, Length);
+				}
+			}
+
+			return true;
+		}
+
+		void PatchBlob(const TArray<uint8>& Base, const FRegistryDelta::FBlobPatch& Patch, TArray<uint8>& OutBlob)
+		{
+			constexpr int32 PageSize = FRegistryDelta::PageSize;
+
+			OutBlob.SetNumUninitialized(Patch.Size);
+			FMemory::Memcpy(OutBlob.GetData(), Base.GetData(), FMath::Min(Base.Num(), Patch.Size));
+
+			int32 ReadOffset = 0;
+			for (const int32 Page : Patch.Pages)
+			{
+				const int32 Offset = Page * PageSize;
+				const int32 Length = FMath::Min(PageSize, Patch.Size - Offset);
+				FMemory::Memcpy(OutBlob.GetData() + Offset, Patch.Data.GetData() + ReadOffset, Length);
+				ReadOffset += Length;
+			}
+
+			check(ReadOffset == Patch.Data.Num());
+		}
+	}
+
+	void MakeDelta(const FRegistrySnapshot& Base, const FRegistrySnapshot& Current, FRegistryDelta& OutDelta)
+	{
+		OutDelta.BaseTick = Base.Tick;
+		OutDelta.Tick = Current.Tick;
+		OutDelta.Entities.Reset();
+		OutDelta.Storages.Reset();
+		OutDelta.RemovedStorages.Reset();
+
+		FRegistryDelta::FBlobPatch EntityPatch;
+		if (DiffBlob(Base.EntityData, Current.EntityData, EntityPatch))
+		{
+			OutDelta.Entities.Emplace(MoveTemp(EntityPatch));
+		}
+
+		static const TArray<uint8> EmptyBlob;
+		for (const TPair<FName, TArray<uint8>>& Pair : Current.Storages)
+		{
+			const TArray<uint8>* BaseBlob = Base.Storages.Find(Pair.Key);
+
+			FRegistryDelta::FBlobPatch Patch;
+			if (DiffBlob(BaseBlob ? *BaseBlob : EmptyBlob, Pair.Value, Patch))
+			{
+				OutDelta.Storages.Add(Pair.Key, MoveTemp(Patch));
+			}
+		}
+
+		for (const TPair<FName, TArray<uint8>>& Pair : Base.Storages)
+		{
+			if (!Current.Storages.Contains(Pair.Key))
+			{
+				OutDelta.RemovedStorages.Add(Pair.Key);
+			}
+		}
+	}
+
+	void ApplyDelta(const FRegistrySnapshot& Base, const FRegistryDelta& Delta, FRegistrySnapshot& OutSnapshot)
+	{
+		checkf(&Base != &OutSnapshot, TEXT("Kz::ECS: ApplyDelta cannot patch its base in place."));
+		ensureMsgf(Base.Tick == Delta.BaseTick, TEXT("Kz::ECS: applying a delta to a different base snapshot than it was made from."));
+
+		OutSnapshot.Tick = Delta.Tick;
+
+		if (Delta.Entities.IsSet())
+		{
+			PatchBlob(Base.EntityData, Delta.Entities.GetValue(), OutSnapshot.EntityData);
+		}
+		else
+		{
+			OutSnapshot.EntityData = Base.EntityData;
+		}
+
+		OutSnapshot.Storages.Reset();
+		for (const TPair<FName, TArray<uint8>>& Pair : Base.Storages)
+		{
+			if (!Delta.Storages.Contains(Pair.Key) && !Delta.RemovedStorages.Contains(Pair.Key))
+			{
+				OutSnapshot.Storages.Add(Pair.Key, Pair.Value);
+			}
+		}
+
+		static const TArray<uint8> EmptyBlob;
+		for (const TPair<FName, FRegistryDelta::FBlobPatch>& Pair : Delta.Storages)
+		{
+			const TArray<uint8>* BaseBlob = Base.Storages.Find(Pair.Key);
+			PatchBlob(BaseBlob ? *BaseBlob : EmptyBlob, Pair.Value, OutSnapshot.Storages.Add(Pair.Key));
+		}
+	}
+
+} // namespace Kz::ECS
@@ -0,0 +1,207 @@
+// Copyright 2026 kirzo
+
+#include "Misc/AutomationTest.h"
+#include "KzEcsRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace KzEcsSnapshotTests
+{
+	/** Trivially copyable: snapshotted as one raw block. */
+	struct FTestTransform
+	{
+		FVector Position = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+	};
+
+	/** Not trivially copyable: snapshotted per component through operator<<. */
+	struct FTestInventory
+	{
+		FString Owner;
+		TArray<int32> Items;
+
+		friend FArchive& operator<<(FArchive& Ar, FTestInventory& Inventory)
+		{
+			return Ar << Inventory.Owner << Inventory.Items;
+		}
+	};
+
+	static constexpr int32 NumEntities = 100000;
+
+	static void Populate(Kz::ECS::Registry& Registry, TArray<Kz::ECS::Entity>& OutEntities)
+	{
+		Registry.ReserveComponents<FTestTransform>(NumEntities);
+		Registry.ReserveComponents<FTestInventory>(NumEntities / 2);
+
+		OutEntities.Reserve(NumEntities);
+		for (int32 i = 0; i < NumEntities; ++i)
+		{
+			const Kz::ECS::Entity E = Registry.CreateEntity();
+			OutEntities.Add(E);
+
+			Registry.AddComponent(E, FTestTransform{ FVector(i, 0, 0), FVector(0, 1, 0) });
+			if (i % 2 == 0)
+			{
+				Registry.AddComponent(E, FTestInventory{ FString::Printf(TEXT("Entity%d"), i), { i, i + 1, i + 2 } });
+			}
+		}
+	}
+
+	/** Edits a part of the world: moves entities, rewrites inventories, destroys some and creates new ones. */
+	static void Mutate(Kz::ECS::Registry& Registry, const TArray<Kz::ECS::Entity>& Entities)
+	{
+		for (int32 i = 0; i < Entities.Num(); i += 10)
+		{
+			Registry.GetComponent<FTestTransform>(Entities[i]).Position.Z += 1.0;
+			if (FTestInventory* Inventory = Registry.FindComponent<FTestInventory>(Entities[i]))
+			{
+				Inventory->Items.Add(-1);
+			}
+		}
+
+		for (int32 i = 1; i < Entities.Num(); i += 97)
+		{
+			Registry.DestroyEntity(Entities[i]);
+		}
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			Registry.AddComponent(Registry.CreateEntity(), FTestInventory{ TEXT("New"), {} });
+		}
+	}
+
+	/** Compares the world content of two snapshots; the tick is not part of it. */
+	static bool HaveSameContent(const Kz::ECS::FRegistrySnapshot& A, const Kz::ECS::FRegistrySnapshot& B)
+	{
+		if (A.EntityData != B.EntityData || A.Storages.Num() != B.Storages.Num())
+		{
+			return false;
+		}
+
+		for (const TPair<FName, TArray<uint8>>& Pair : A.Storages)
+		{
+			const TArray<uint8>* Other = B.Storages.Find(Pair.Key);
+			if (!Other || *Other != Pair.Value)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static double ElapsedMs(double StartSeconds)
+	{
+		return (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKzEcsSnapshotRoundTripTest, "KzLib.ECS.Snapshot.RoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FKzEcsSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace KzEcsSnapshotTests;
+
+	Kz::ECS::Registry Registry;
+	TArray<Kz::ECS::Entity> Entities;
+	Populate(Registry, Entities);
+
+	Kz::ECS::FRegistrySnapshot Before;
+	Registry.TakeSnapshot(Before);
+
+	// Restoring the snapshot just taken must leave the registry unchanged.
+	Registry.RestoreSnapshot(Before);
+
+	Kz::ECS::FRegistrySnapshot After;
+	Registry.TakeSnapshot(After);
+	TestTrue(TEXT("RestoreSnapshot(TakeSnapshot()) leaves the registry unchanged"), HaveSameContent(Before, After));
+
+	// Restoring after edits must bring back the original world, entity generations included.
+	Mutate(Registry, Entities);
+	Registry.RestoreSnapshot(Before);
+	Registry.TakeSnapshot(After);
+	TestTrue(TEXT("Restoring after edits brings back the snapshot content"), HaveSameContent(Before, After));
+
+	bool bComponentsMatch = true;
+	for (int32 i = 0; i < Entities.Num() && bComponentsMatch; ++i)
+	{
+		const Kz::ECS::Registry& ConstRegistry = Registry;
+		const FTestTransform* Transform = ConstRegistry.FindComponent<FTestTransform>(Entities[i]);
+		const FTestInventory* Inventory = ConstRegistry.FindComponent<FTestInventory>(Entities[i]);
+
+		bComponentsMatch = Registry.IsAlive(Entities[i])
+			&& Transform && Transform->Position == FVector(i, 0, 0)
+			&& (i % 2 == 0 ? Inventory && Inventory->Items.Num() == 3 && Inventory->Owner == FString::Printf(TEXT("Entity%d"), i) : !Inventory);
+	}
+	TestTrue(TEXT("Every original entity is alive with its original components"), bComponentsMatch);
+
+	// A delta applied to its base must rebuild the snapshot it was made from.
+	Mutate(Registry, Entities);
+	Kz::ECS::FRegistrySnapshot Current;
+	Registry.TakeSnapshot(Current);
+
+	Kz::ECS::FRegistryDelta Delta;
+	Kz::ECS::MakeDelta(Before, Current, Delta);
+
+	Kz::ECS::FRegistrySnapshot Patched;
+	Kz::ECS::ApplyDelta(Before, Delta, Patched);
+	TestTrue(TEXT("ApplyDelta(Base, MakeDelta(Base, Current)) equals Current"), HaveSameContent(Current, Patched));
+	TestEqual(TEXT("Patched snapshot tick"), Patched.Tick, Current.Tick);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FKzEcsSnapshotBenchmarkTest, "KzLib.ECS.Snapshot.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FKzEcsSnapshotBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace KzEcsSnapshotTests;
+
+	Kz::ECS::Registry Registry;
+	TArray<Kz::ECS::Entity> Entities;
+	Populate(Registry, Entities);
+
+	Kz::ECS::FRegistrySnapshot Base;
+	double Start = FPlatformTime::Seconds();
+	Registry.TakeSnapshot(Base);
+	const double TakeMs = ElapsedMs(Start);
+
+	Start = FPlatformTime::Seconds();
+	Registry.RestoreSnapshot(Base);
+	const double RestoreMs = ElapsedMs(Start);
+
+	Mutate(Registry, Entities);
+	Kz::ECS::FRegistrySnapshot Current;
+	Registry.TakeSnapshot(Current);
+
+	Kz::ECS::FRegistryDelta Delta;
+	Start = FPlatformTime::Seconds();
+	Kz::ECS::MakeDelta(Base, Current, Delta);
+	const double MakeDeltaMs = ElapsedMs(Start);
+
+	Kz::ECS::FRegistrySnapshot Patched;
+	Start = FPlatformTime::Seconds();
+	Kz::ECS::ApplyDelta(Base, Delta, Patched);
+	const double ApplyDeltaMs = ElapsedMs(Start);
+
+	int64 DeltaBytes = 0;
+	for (const TPair<FName, Kz::ECS::FRegistryDelta::FBlobPatch>& Pair : Delta.Storages)
+	{
+		DeltaBytes += Pair.Value.Data.Num();
+	}
+	if (Delta.Entities.IsSet())
+	{
+		DeltaBytes += Delta.Entities->Data.Num();
+	}
+
+	AddInfo(FString::Printf(TEXT("%d entities (half with a non-trivial component), snapshot %lld bytes"), NumEntities, Current.GetAllocatedSize()));
+	AddInfo(FString::Printf(TEXT("TakeSnapshot %.2f ms, RestoreSnapshot %.2f ms"), TakeMs, RestoreMs));
+	AddInfo(FString::Printf(TEXT("MakeDelta %.2f ms, ApplyDelta %.2f ms, delta %lld bytes"), MakeDeltaMs, ApplyDeltaMs, DeltaBytes));
+
+	TestTrue(TEXT("Delta round trip"), HaveSameContent(Current, Patched));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
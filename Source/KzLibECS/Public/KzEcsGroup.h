@@ -0,0 +1,110 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KzEcsRegistry.h"
+
+namespace Kz::ECS
+{
+	/**
+	 * Owning group over a fixed set of component types.
+	 *
+	 * The registry keeps every entity that owns all of the group's components packed at the front
+	 * of each owned storage, in the same order. Iterating the group therefore walks the dense arrays
+	 * in lockstep: no sparse lookups, no gathers, and no rejected entities.
+	 *
+	 * Example:
+	 *   for (auto [e, pos, vel] : registry.Group<FPosition, FVelocity>())
+	 *   {
+	 *       pos.Value += vel.Value * Dt;
+	 *   }
+	 *
+	 * Storages can be reordered for locality with Storage<T>::Sort(); on an owned storage the
+	 * group prefix is sorted as a unit and the order is mirrored to every owned storage.
+	 */
+	template<typename... Owned>
+	class TGroup
+	{
+	public:
+		TGroup(FOwningGroup& InGroup, Storage<Owned>&... InStorages)
+			: Group(InGroup)
+			, Storages(&InStorages...)
+		{
+		}
+
+		/** Number of entities currently in the group. */
+		int32 Num() const { return Group.Size; }
+
+		bool IsEmpty() const { return Group.Size == 0; }
+
+		/** Entity at a position of the group. Positions are shared by every owned storage. */
+		Entity GetEntity(int32 Index) const
+		{
+			return Storages.template Get<0>()->GetEntities()[Index];
+		}
+
+		/** Calls a lambda for each entity in the group. */
+		template<typename Func>
+		void ForEach(Func&& F)
+		{
+			const int32 Count = Group.Size;
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				F(GetEntity(Index), GetComponent<Owned>(Index)...);
+			}
+		}
+
+		/** Runs the lambda in parallel for all entities of the group. */
+		template<typename Func>
+		void ParallelForEach(Func&& F)
+		{
+			ParallelFor(Group.Size, [this, &F](int32 Index)
+			{
+				F(GetEntity(Index), GetComponent<Owned>(Index)...);
+			});
+		}
+
+		// ======================================================
+		// Iterator definition
+		// ======================================================
+		struct Iterator
+		{
+			TGroup& Owner;
+			int32 Index;
+
+			bool operator!=(const Iterator& Other) const
+			{
+				return Index != Other.Index;
+			}
+
+			/**
+			 * Dereferences the iterator and returns a tuple:
+			 *   (entity, compA&, compB&, ...)
+			 */
+			auto operator*()
+			{
+				return TTuple<Entity, Owned&...>(Owner.GetEntity(Index), Owner.template GetComponent<Owned>(Index)...);
+			}
+
+			Iterator& operator++()
+			{
+				++Index;
+				return *this;
+			}
+		};
+
+		Iterator begin() { return Iterator{ *this, 0 }; }
+		Iterator end() { return Iterator{ *this, Group.Size }; }
+
+	private:
+		FOwningGroup& Group;
+		TTuple<Storage<Owned>*...> Storages;
+
+		template<typename T>
+		T& GetComponent(int32 Index) const
+		{
+			return Storages.template Get<TTupleIndex<T, TTuple<Owned...>>::Value>()->GetByIndex(Index);
+		}
+	};
+} // namespace Kz::ECS
@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 #include "KzEcsEntity.h"
 #include "KzEcsStorage.h"
+#include "KzEcsSnapshot.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 namespace Kz::ECS
 {
@@ -17,6 +22,9 @@ namespace Kz::ECS
 	template<typename... Components>
 	using ConstView = TView<true, TTuple<Components...>, TTuple<>>;
 
+	template<typename... Owned>
+	class TGroup;
+
 	/**
 	 * Central ECS registry.
 	 *
@@ -25,10 +33,19 @@ namespace Kz::ECS
 	 *   - Managing component storages per type
 	 *   - Adding/getting/removing components for entities
 	 *   - Maintaining safety via generational handles
+	 *   - Keeping the world tick used to stamp component changes
+	 *   - Taking and restoring binary snapshots of the whole world
 	 */
 	class Registry
 	{
 	public:
+		Registry() = default;
+
+		// Storages point at CurrentTick (see IStorage::SetTickSource), so the registry must stay where it was created.
+		Registry(const Registry&) = delete;
+		Registry& operator=(const Registry&) = delete;
+		Registry(Registry&&) = delete;
+		Registry& operator=(Registry&&) = delete;
 
 		// ============================================================
 		//  Entity lifetime
@@ -80,6 +97,41 @@ namespace Kz::ECS
 			return GetOrCreateStorage<T>().Add(E, Value);
 		}
 
+		template<typename T> requires (!std::is_reference_v<T>)
+		T& AddComponent(const Entity& E, T&& Value)
+		{
+			check(IsAlive(E));
+			return GetOrCreateStorage<T>().Add(E, MoveTemp(Value));
+		}
+
+		/**
+		 * Constructs a component of type T in place, forwarding Args to its constructor.
+		 */
+		template<typename T, typename... ArgTypes>
+		T& EmplaceComponent(const Entity& E, ArgTypes&&... Args)
+		{
+			check(IsAlive(E));
+			return GetOrCreateStorage<T>().Emplace(E, Forward<ArgTypes>(Args)...);
+		}
+
+		/**
+		 * Adds a copy of Value to every entity in the list with a single storage lookup.
+		 */
+		template<typename T>
+		void AddComponents(TArrayView<const Entity> InEntities, const T& Value)
+		{
+			GetOrCreateStorage<T>().AddMany(InEntities, Value);
+		}
+
+		/**
+		 * Preallocates room for Number components of type T.
+		 */
+		template<typename T>
+		void ReserveComponents(int32 Number)
+		{
+			GetOrCreateStorage<T>().Reserve(Number);
+		}
+
 		template<typename T>
 		bool HasComponent(const Entity& E) const
 		{
@@ -87,11 +139,16 @@ namespace Kz::ECS
 			return S && S->Contains(E);
 		}
 
+		/**
+		 * Mutable access. Counts as a change: the component is stamped with the current tick.
+		 */
 		template<typename T>
 		T& GetComponent(const Entity& E)
 		{
 			check(IsAlive(E));
-			return GetOrCreateStorage<T>().Get(E);
+			Storage<T>& S = GetOrCreateStorage<T>();
+			S.MarkChanged(E);
+			return S.Get(E);
 		}
 
 		template<typename T>
@@ -103,11 +160,17 @@ namespace Kz::ECS
 			return S->Get(E);
 		}
 
+		/**
+		 * Mutable lookup. Counts as a change when the component exists.
+		 */
 		template<typename T>
 		T* FindComponent(const Entity& E)
 		{
 			Storage<T>* S = GetStorage<T>();
-			return S ? S->Find(E) : nullptr;
+			if (!S) return nullptr;
+
+			S->MarkChanged(E);
+			return S->Find(E);
 		}
 
 		template<typename T>
@@ -124,6 +187,133 @@ namespace Kz::ECS
 			if (S) S->Remove(E);
 		}
 
+		// ============================================================
+		//  Change tracking
+		// ============================================================
+
+		/**
+		 * Stamps the entity's T component as changed at the current tick.
+		 * Views hand out plain references, so writes made through them must be reported here.
+		 */
+		template<typename T>
+		void MarkChanged(const Entity& E)
+		{
+			if (Storage<T>* S = GetStorage<T>()) S->MarkChanged(E);
+		}
+
+		/**
+		 * Invokes Func with the entity's T component and stamps it as changed.
+		 * @return false if the entity has no T component.
+		 */
+		template<typename T, typename Func>
+		bool Patch(const Entity& E, Func&& F)
+		{
+			Storage<T>* S = GetStorage<T>();
+			T* Component = S ? S->Find(E) : nullptr;
+			if (!Component) return false;
+
+			::Invoke(Forward<Func>(F), *Component);
+			S->MarkChanged(E);
+			return true;
+		}
+
+		/** Current world tick. Every add/change is stamped with this value. */
+		uint32 GetTick() const { return CurrentTick; }
+
+		/**
+		 * Advances the world tick and returns the new value.
+		 * SystemGroup calls this before every system and after the last one, so each system sees a
+		 * distinct tick and edits made between updates are newer than any system's last run.
+		 */
+		uint32 AdvanceTick() { return ++CurrentTick; }
+
+		// ============================================================
+		//  Snapshots
+		// ============================================================
+
+		/**
+		 * Gives component type T a stable snapshot name.
+		 *
+		 * Unnamed types get a name derived from their runtime type id, which depends on the order
+		 * types were first used: fine for rollback and cloning inside a session, but snapshots
+		 * written to disk should only contain named types. Registering a type also lets
+		 * RestoreSnapshot() create its storage in a registry that never used it.
+		 */
+		template<typename T>
+		static void RegisterComponentType(FName SnapshotName)
+		{
+			check(!SnapshotName.IsNone());
+			RegisterType<T>(SnapshotName);
+		}
+
+		/**
+		 * Captures the entity pool and every serializable storage into OutSnapshot.
+		 * Storages whose component type cannot be serialized (see Storage<T>::bSerializable) are skipped.
+		 */
+		void TakeSnapshot(FRegistrySnapshot& OutSnapshot) const
+		{
+			OutSnapshot.Reset();
+			OutSnapshot.Tick = CurrentTick;
+
+			{
+				FMemoryWriter Writer(OutSnapshot.EntityData);
+				Entities.Serialize(Writer);
+			}
+
+			for (const TPair<uint32, TUniquePtr<IStorage>>& Pair : Storages)
+			{
+				IStorage* S = Pair.Value.Get();
+				if (!S->CanSerialize())
+					continue;
+
+				FMemoryWriter Writer(OutSnapshot.Storages.Add(GetSnapshotName(Pair.Key)));
+				S->Serialize(Writer);
+			}
+		}
+
+		/**
+		 * Replaces the registry content with the snapshot.
+		 *
+		 * Storages are loaded as whole blocks and their sparse lookups rebuilt; no per-entity add
+		 * is performed. Restored components count as added at the current tick (which is not
+		 * rewound), so change-tracking systems pick them up, and OnRemoved() listeners are told
+		 * about every component that was replaced. Owning groups are rebuilt afterwards.
+		 * Storages that cannot be serialized are not in the snapshot and are cleared: their
+		 * components belong to entities of the replaced pool.
+		 */
+		void RestoreSnapshot(const FRegistrySnapshot& Snapshot)
+		{
+			{
+				FMemoryReader Reader(Snapshot.EntityData);
+				Entities.Serialize(Reader);
+			}
+
+			// Serializable storages absent from the snapshot were empty (or not yet created) when it was taken.
+			for (const TPair<uint32, TUniquePtr<IStorage>>& Pair : Storages)
+			{
+				IStorage* S = Pair.Value.Get();
+				if (!S->CanSerialize() || !Snapshot.Storages.Contains(GetSnapshotName(Pair.Key)))
+				{
+					S->Clear();
+				}
+			}
+
+			for (const TPair<FName, TArray<uint8>>& Pair : Snapshot.Storages)
+			{
+				IStorage* S = GetOrCreateStorageByName(Pair.Key);
+				if (!ensureMsgf(S, TEXT("Kz::ECS: snapshot contains unknown component type '%s'."), *Pair.Key.ToString()))
+					continue;
+
+				FMemoryReader Reader(Pair.Value);
+				S->Serialize(Reader);
+			}
+
+			for (const TPair<FGroupKey, TUniquePtr<FOwningGroup>>& Pair : Groups)
+			{
+				Pair.Value->Build();
+			}
+		}
+
 		// ============================================================
 		//  Direct storage access (used internally)
 		// ============================================================
@@ -136,7 +326,7 @@ namespace Kz::ECS
 
 			if (!BasePtr.IsValid())
 			{
-				BasePtr = MakeUnique<Storage<T>>();
+				BasePtr = RegisterType<T>().CreateStorage(&CurrentTick);
 			}
 
 			return *static_cast<Storage<T>*>(BasePtr.Get());
@@ -201,6 +391,44 @@ namespace Kz::ECS
 			return Kz::ECS::ConstView<Components...>(const_cast<Registry&>(*this));
 		}
 
+		/**
+		 * Returns the owning group for the given component types, creating it on first use.
+		 *
+		 * While the group exists, entities owning all of Owned are kept packed at the front of each
+		 * owned storage in the same order, maintained on every add/remove. A storage can be owned by
+		 * only one group; asking for a different group over an already owned storage is an error.
+		 * The order of Owned doesn't matter: Group<A, B>() and Group<B, A>() share the same group.
+		 *
+		 * @tparam Owned  Two or more component types iterated together in the hot loop.
+		 */
+		template<typename... Owned>
+		TGroup<Owned...> Group()
+		{
+			static_assert(sizeof...(Owned) > 1, "An owning group needs at least two component types.");
+
+			FGroupKey Key;
+			(Key.TypeIds.Add(TypeId<Owned>()), ...);
+			Key.TypeIds.Sort();
+
+			TUniquePtr<FOwningGroup>& GroupPtr = Groups.FindOrAdd(MoveTemp(Key));
+			if (!GroupPtr.IsValid())
+			{
+				checkf(((GetOrCreateStorage<Owned>().GetOwningGroup() == nullptr) && ...), TEXT("Kz::ECS: a component storage can only be owned by one group."));
+
+				GroupPtr = MakeUnique<FOwningGroup>();
+				(GroupPtr->Owned.Add(&GetOrCreateStorage<Owned>()), ...);
+				(GetOrCreateStorage<Owned>().SetOwningGroup(GroupPtr.Get()), ...);
+				GroupPtr->Build();
+			}
+
+			FOwningGroup* Existing = GroupPtr.Get();
+
+			checkf(Existing->Owned.Num() == sizeof...(Owned) && ((GetOrCreateStorage<Owned>().GetOwningGroup() == Existing) && ...),
+				TEXT("Kz::ECS: conflicting owning group requested over an already owned storage."));
+
+			return TGroup<Owned...>(*Existing, GetOrCreateStorage<Owned>()...);
+		}
+
 		template<typename... Components, typename Func>
 		void ForEach(Func&& F)
 		{
@@ -217,6 +445,106 @@ namespace Kz::ECS
 		EntityPool Entities;
 		TMap<uint32, TUniquePtr<IStorage>> Storages;
 
+		// Starts at 1 so that "changed since 0" matches every component.
+		uint32 CurrentTick = 1;
+
+		/** Sorted type ids of a group's owned components, so Group<A, B> and Group<B, A> are the same group. */
+		struct FGroupKey
+		{
+			TArray<uint32, TInlineAllocator<4>> TypeIds;
+
+			bool operator==(const FGroupKey& Other) const { return TypeIds == Other.TypeIds; }
+
+			friend uint32 GetTypeHash(const FGroupKey& Key)
+			{
+				uint32 Hash = 0;
+				for (uint32 Id : Key.TypeIds)
+				{
+					Hash = HashCombineFast(Hash, Id);
+				}
+				return Hash;
+			}
+		};
+
+		// Owning groups. Heap-allocated so owned storages can keep pointers to them.
+		TMap<FGroupKey, TUniquePtr<FOwningGroup>> Groups;
+
+		/** Type-erased knowledge about a component type, filled the first time the type is used. */
+		struct FComponentType
+		{
+			TUniquePtr<IStorage>(*CreateStorage)(const uint32* TickSource) = nullptr;
+			FName SnapshotName;
+		};
+
+		/** Shared by every registry, so guarded by ComponentTypesLock. */
+		inline static TMap<uint32, FComponentType> ComponentTypes;
+		inline static FRWLock ComponentTypesLock;
+
+		/** Registers T (and optionally its snapshot name) and returns a copy of its type info. */
+		template<typename T>
+		static FComponentType RegisterType(FName SnapshotName = NAME_None)
+		{
+			FWriteScopeLock WriteLock(ComponentTypesLock);
+
+			FComponentType& Type = ComponentTypes.FindOrAdd(TypeId<T>());
+			if (!Type.CreateStorage)
+			{
+				Type.CreateStorage = [](const uint32* TickSource) -> TUniquePtr<IStorage>
+				{
+					TUniquePtr<Storage<T>> NewStorage = MakeUnique<Storage<T>>();
+					NewStorage->SetTickSource(TickSource);
+					return NewStorage;
+				};
+			}
+			if (!SnapshotName.IsNone())
+			{
+				Type.SnapshotName = SnapshotName;
+			}
+			return Type;
+		}
+
+		static FName GetSnapshotName(uint32 Id)
+		{
+			FReadScopeLock ReadLock(ComponentTypesLock);
+			return GetSnapshotNameLocked(Id, ComponentTypes.Find(Id));
+		}
+
+		/** Requires ComponentTypesLock. */
+		static FName GetSnapshotNameLocked(uint32 Id, const FComponentType* Type)
+		{
+			return Type && !Type->SnapshotName.IsNone() ? Type->SnapshotName : FName(TEXT("KzEcsComponent"), Id + 1);
+		}
+
+		IStorage* GetOrCreateStorageByName(FName SnapshotName)
+		{
+			uint32 Id = 0;
+			TUniquePtr<IStorage>(*CreateStorage)(const uint32* TickSource) = nullptr;
+			{
+				FReadScopeLock ReadLock(ComponentTypesLock);
+				for (const TPair<uint32, FComponentType>& Pair : ComponentTypes)
+				{
+					if (GetSnapshotNameLocked(Pair.Key, &Pair.Value) == SnapshotName)
+					{
+						Id = Pair.Key;
+						CreateStorage = Pair.Value.CreateStorage;
+						break;
+					}
+				}
+			}
+
+			if (!CreateStorage)
+			{
+				return nullptr;
+			}
+
+			TUniquePtr<IStorage>& BasePtr = Storages.FindOrAdd(Id);
+			if (!BasePtr.IsValid())
+			{
+				BasePtr = CreateStorage(&CurrentTick);
+			}
+			return BasePtr.Get();
+		}
+
 		/**
 		 * Statically-assigned unique type ID for each component T.
 		 */
@@ -227,7 +555,8 @@ namespace Kz::ECS
 			return ID;
 		}
 
-		inline static uint32 Counter = 0;
+		// Atomic: types may be seen for the first time on different threads.
+		inline static std::atomic<uint32> Counter = 0;
 	};
 
 } // namespace Kz::ECS
\ No newline at end of file
@@ -0,0 +1,106 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Kz::ECS
+{
+	/**
+	 * Full binary image of a Registry (see Registry::TakeSnapshot / RestoreSnapshot).
+	 *
+	 * Holds one blob for the entity pool (slots, generations and free list) and one blob per
+	 * component storage, keyed by the component's snapshot name. Trivially copyable storages
+	 * are raw copies of their dense arrays, so taking and restoring a snapshot is dominated by
+	 * memcpy rather than per-entity work.
+	 */
+	struct FRegistrySnapshot
+	{
+		/** Registry tick at which the snapshot was taken. */
+		uint32 Tick = 0;
+
+		TArray<uint8> EntityData;
+		TMap<FName, TArray<uint8>> Storages;
+
+		void Reset()
+		{
+			Tick = 0;
+			EntityData.Reset();
+			Storages.Reset();
+		}
+
+		/** Number of bytes held by the snapshot blobs. */
+		int64 GetAllocatedSize() const
+		{
+			int64 Size = EntityData.Num();
+			for (const TPair<FName, TArray<uint8>>& Pair : Storages)
+			{
+				Size += Pair.Value.Num();
+			}
+			return Size;
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FRegistrySnapshot& Snapshot)
+		{
+			return Ar << Snapshot.Tick << Snapshot.EntityData << Snapshot.Storages;
+		}
+	};
+
+	/**
+	 * Difference between two snapshots, at fixed-size page granularity.
+	 *
+	 * Only storages whose bytes changed are present, and for each of them only the pages that
+	 * differ from the base are stored. Applying the delta to the same base snapshot yields an
+	 * exact copy of the snapshot the delta was made from.
+	 */
+	struct FRegistryDelta
+	{
+		/** Granularity of the page comparison, in bytes. */
+		static constexpr int32 PageSize = 4096;
+
+		/** Changed pages of a single blob. */
+		struct FBlobPatch
+		{
+			/** Size of the blob after patching. */
+			int32 Size = 0;
+
+			/** Indices of the stored pages, ascending. Data holds them back to back (the last page of a blob may be short). */
+			TArray<int32> Pages;
+			TArray<uint8> Data;
+
+			friend FArchive& operator<<(FArchive& Ar, FBlobPatch& Patch)
+			{
+				return Ar << Patch.Size << Patch.Pages << Patch.Data;
+			}
+		};
+
+		uint32 BaseTick = 0;
+		uint32 Tick = 0;
+
+		/** Set when the entity pool changed. */
+		TOptional<FBlobPatch> Entities;
+
+		/** Storages that changed or did not exist in the base. */
+		TMap<FName, FBlobPatch> Storages;
+
+		/** Storages present in the base but not in the new snapshot. */
+		TArray<FName> RemovedStorages;
+
+		bool IsEmpty() const
+		{
+			return !Entities.IsSet() && Storages.IsEmpty() && RemovedStorages.IsEmpty();
+		}
+
+		friend FArchive& operator<<(FArchive& Ar, FRegistryDelta& Delta)
+		{
+			return Ar << Delta.BaseTick << Delta.Tick << Delta.Entities << Delta.Storages << Delta.RemovedStorages;
+		}
+	};
+
+	/** Encodes the pages of Current that differ from Base. */
+	KZLIBECS_API void MakeDelta(const FRegistrySnapshot& Base, const FRegistrySnapshot& Current, FRegistryDelta& OutDelta);
+
+	/** Rebuilds the snapshot a delta was made from, given the same base. */
+	KZLIBECS_API void ApplyDelta(const FRegistrySnapshot& Base, const FRegistryDelta& Delta, FRegistrySnapshot& OutSnapshot);
+
+} // namespace Kz::ECS
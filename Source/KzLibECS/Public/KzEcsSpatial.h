@@ -0,0 +1,224 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KzEcsRegistry.h"
+#include "KzEcsSystem.h"
+#include "KzEcsView.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Spatial/KzSpatialRegistry.h"
+
+namespace Kz::ECS
+{
+	/**
+	 * Component that makes an entity visible to SpatialIndexSystem.
+	 *
+	 * Bounds are cached from the shape and transform; call SetTransform() (or UpdateBounds() after
+	 * editing Shape directly) through a mutable access so the change tick is stamped.
+	 */
+	struct FSpatialProxy
+	{
+		FKzShapeInstance Shape;
+		FVector Position = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		FBox Bounds = FBox(ForceInitToZero);
+
+		/** Dynamic proxies are expected to move and are indexed in the dynamic grid. */
+		bool bDynamic = true;
+
+		FSpatialProxy() = default;
+
+		FSpatialProxy(const FKzShapeInstance& InShape, const FVector& InPosition, const FQuat& InRotation = FQuat::Identity, bool bInDynamic = true)
+			: Shape(InShape)
+			, Position(InPosition)
+			, Rotation(InRotation)
+			, bDynamic(bInDynamic)
+		{
+			UpdateBounds();
+		}
+
+		void SetTransform(const FVector& InPosition, const FQuat& InRotation)
+		{
+			Position = InPosition;
+			Rotation = InRotation;
+			UpdateBounds();
+		}
+
+		void UpdateBounds()
+		{
+			Bounds = Shape.GetBoundingBox(Position, Rotation);
+		}
+	};
+
+	/**
+	 * Stable snapshot of a proxy as seen by the spatial index.
+	 * Grids hold pointers to these, so they never move while the entity is indexed.
+	 */
+	struct FSpatialRecord
+	{
+		Entity Owner;
+		FSpatialProxy Proxy;
+	};
+
+	/** TSpatialRegistry semantics over FSpatialRecord pointers, identified by their entity. */
+	struct FSpatialSemantics
+	{
+		using ElementIdType = Entity;
+
+		static FBox GetBoundingBox(const FSpatialRecord* Record) { return Record->Proxy.Bounds; }
+		static Entity GetElementId(const FSpatialRecord* Record) { return Record->Owner; }
+		static FVector GetElementPosition(const FSpatialRecord* Record) { return Record->Proxy.Position; }
+		static FQuat GetElementRotation(const FSpatialRecord* Record) { return Record->Proxy.Rotation; }
+		static FKzShapeInstance GetShape(const FSpatialRecord* Record) { return Record->Proxy.Shape; }
+		static bool IsValid(const FSpatialRecord* Record) { return Record != nullptr; }
+		static bool IsDynamic(const FSpatialRecord* Record) { return Record->Proxy.bDynamic; }
+	};
+
+	/**
+	 * Keeps a TSpatialRegistry in sync with every entity that has an FSpatialProxy.
+	 *
+	 * Only proxies added or changed since the previous Update() are visited (via change tracking),
+	 * and removals are picked up through the storage's OnRemoved() event, so the per-frame cost
+	 * follows the number of entities that actually moved rather than the number indexed.
+	 *
+	 * Example:
+	 *   SpatialIndexSystem* Spatial = Systems.AddSystem<SpatialIndexSystem>(Registry);
+	 *   ...
+	 *   TArray<Entity> Neighbours;
+	 *   Spatial->FindNearest(Neighbours, Position, 8, 1000.0f);
+	 *
+	 * The system must not outlive the registry it was created for.
+	 */
+	class SpatialIndexSystem : public ISystem
+	{
+	public:
+		explicit SpatialIndexSystem(Registry& InRegistry, float CellSize = 100.0f)
+			: ProxyStorage(InRegistry.GetOrCreateStorage<FSpatialProxy>())
+		{
+			Spatial.SetCellSize(CellSize);
+			RemovedHandle = ProxyStorage.OnRemoved().AddRaw(this, &SpatialIndexSystem::HandleProxyRemoved);
+		}
+
+		virtual ~SpatialIndexSystem() override
+		{
+			ProxyStorage.OnRemoved().Remove(RemovedHandle);
+		}
+
+		SpatialIndexSystem(const SpatialIndexSystem&) = delete;
+		SpatialIndexSystem& operator=(const SpatialIndexSystem&) = delete;
+
+		virtual void Update(float DeltaTime, Registry& R) override
+		{
+			SyncChanged(R);
+
+			// SystemGroup advances the tick after the last system, so later edits are newer than this.
+			LastSyncTick = R.GetTick();
+		}
+
+		/**
+		 * Pushes every proxy added or changed since the last sync into the spatial index.
+		 * For use outside a SystemGroup: closes the current tick itself so later edits are not missed.
+		 */
+		void Sync(Registry& R)
+		{
+			SyncChanged(R);
+			LastSyncTick = R.AdvanceTick() - 1;
+		}
+
+		void SetCellSize(float CellSize)
+		{
+			// The grids bucket by cell size, so everything has to be re-inserted.
+			Spatial.Reset();
+			Spatial.SetCellSize(CellSize);
+			for (const TPair<Entity, TUniquePtr<FSpatialRecord>>& Pair : Records)
+			{
+				Spatial.Register(Pair.Value.Get());
+			}
+		}
+
+		void SetReindexThreshold(float Threshold) { Spatial.SetReindexThreshold(Threshold); }
+
+		int32 Num() const { return Records.Num(); }
+
+		// ============================================================
+		//  Queries
+		// ============================================================
+
+		/** Collects entities whose proxy overlaps the given shape. */
+		void Query(TArray<Entity>& OutEntities, const FKzShapeInstance& Shape, const FVector& Position, const FQuat& Rotation = FQuat::Identity) const
+		{
+			Spatial.Query(OutEntities, Shape, Position, Rotation);
+		}
+
+		/**
+		 * Returns the closest entity hit by the ray.
+		 * @param RayLength  Ray length. <= 0 means infinite.
+		 */
+		bool Raycast(Entity& OutEntity, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength) const
+		{
+			return Spatial.Raycast(OutEntity, OutHit, RayStart, RayDir, RayLength);
+		}
+
+		/** Collects up to K entities closest to Point (distance to their bounds), nearest first. */
+		void FindNearest(TArray<Entity>& OutEntities, const FVector& Point, int32 K, float MaxDistance = UE_BIG_NUMBER) const
+		{
+			Spatial.FindNearest(OutEntities, Point, K, MaxDistance);
+		}
+
+		void DebugDraw(const class UWorld* World, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const
+		{
+			Spatial.DebugDraw(World, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+		}
+
+	private:
+		Storage<FSpatialProxy>& ProxyStorage;
+		FDelegateHandle RemovedHandle;
+
+		Kz::TSpatialRegistry<const FSpatialRecord*, FSpatialSemantics> Spatial;
+		TMap<Entity, TUniquePtr<FSpatialRecord>> Records;
+
+		// "Changed since 0" matches everything, so the first sync indexes existing proxies.
+		uint32 LastSyncTick = 0;
+
+		void SyncChanged(const Registry& R)
+		{
+			for (auto [E, Proxy] : R.View<FSpatialProxy>().Changed<FSpatialProxy>(LastSyncTick))
+			{
+				SyncProxy(E, Proxy);
+			}
+		}
+
+		void SyncProxy(const Entity& E, const FSpatialProxy& Proxy)
+		{
+			TUniquePtr<FSpatialRecord>& Record = Records.FindOrAdd(E);
+			if (!Record.IsValid())
+			{
+				Record = MakeUnique<FSpatialRecord>(FSpatialRecord{ E, Proxy });
+				Spatial.Register(Record.Get());
+				return;
+			}
+
+			// Static cells are never revisited, and a static/dynamic switch changes grids: re-register.
+			if (!Record->Proxy.bDynamic || Record->Proxy.bDynamic != Proxy.bDynamic)
+			{
+				Spatial.Unregister(Record.Get());
+				Record->Proxy = Proxy;
+				Spatial.Register(Record.Get());
+				return;
+			}
+
+			Record->Proxy = Proxy;
+			Spatial.Update(Record.Get());
+		}
+
+		void HandleProxyRemoved(const Entity& E)
+		{
+			if (TUniquePtr<FSpatialRecord>* Record = Records.Find(E))
+			{
+				Spatial.Unregister(Record->Get());
+				Records.Remove(E);
+			}
+		}
+	};
+} // namespace Kz::ECS
@@ -7,6 +7,125 @@
 
 namespace Kz::ECS
 {
+	/**
+	 * Per-component change stamps, kept parallel to a storage's dense arrays.
+	 *
+	 * Every component records the world tick at which it was added and the last tick at
+	 * which it was changed. Dense entries are additionally grouped into fixed-size chunks
+	 * that remember the newest change inside them, so change-filtered views can skip whole
+	 * chunks without touching the per-component stamps.
+	 */
+	struct FComponentTicks
+	{
+		/** Number of dense entries summarised by one chunk stamp. */
+		static constexpr int32 ChunkSize = 64;
+
+		TArray<uint32> Added;        // Tick at which each component was added
+		TArray<uint32> Changed;      // Tick at which each component was last changed (adds count as changes)
+		TArray<uint32> ChunkChanged; // Newest Changed stamp in each chunk (conservative, never lowered)
+
+		/** Appends the stamps for a newly added component. */
+		void Push(uint32 Tick)
+		{
+			const int32 Index = Added.Add(Tick);
+			Changed.Add(Tick);
+
+			if (Index / ChunkSize >= ChunkChanged.Num())
+			{
+				ChunkChanged.Add(Tick);
+			}
+			else
+			{
+				ChunkChanged[Index / ChunkSize] = Tick;
+			}
+		}
+
+		/** Mirrors a swap-remove on the dense arrays. */
+		void RemoveAtSwap(int32 Index)
+		{
+			const int32 LastIndex = Added.Num() - 1;
+			if (Index != LastIndex)
+			{
+				Added[Index] = Added[LastIndex];
+				Changed[Index] = Changed[LastIndex];
+
+				// The moved stamp may be newer than anything else in its new chunk.
+				uint32& Chunk = ChunkChanged[Index / ChunkSize];
+				Chunk = FMath::Max(Chunk, Changed[Index]);
+			}
+
+			Added.Pop(EAllowShrinking::No);
+			Changed.Pop(EAllowShrinking::No);
+			ChunkChanged.SetNum((Added.Num() + ChunkSize - 1) / ChunkSize, EAllowShrinking::No);
+		}
+
+		void MarkChanged(int32 Index, uint32 Tick)
+		{
+			Changed[Index] = Tick;
+			ChunkChanged[Index / ChunkSize] = Tick;
+		}
+
+		void Reserve(int32 Number)
+		{
+			Added.Reserve(Number);
+			Changed.Reserve(Number);
+			ChunkChanged.Reserve((Number + ChunkSize - 1) / ChunkSize);
+		}
+
+		/** Mirrors a swap of two dense entries. */
+		void Swap(int32 A, int32 B)
+		{
+			::Swap(Added[A], Added[B]);
+			::Swap(Changed[A], Changed[B]);
+
+			uint32& ChunkA = ChunkChanged[A / ChunkSize];
+			ChunkA = FMath::Max(ChunkA, Changed[A]);
+			uint32& ChunkB = ChunkChanged[B / ChunkSize];
+			ChunkB = FMath::Max(ChunkB, Changed[B]);
+		}
+
+		/** Mirrors a reorder of the dense range starting at Offset (see IStorage::ApplyPermutation). */
+		void ApplyPermutation(int32 Offset, TArrayView<const int32> Order)
+		{
+			TArray<uint32> OldAdded(Added.GetData() + Offset, Order.Num());
+			TArray<uint32> OldChanged(Changed.GetData() + Offset, Order.Num());
+
+			for (int32 i = 0; i < Order.Num(); ++i)
+			{
+				Added[Offset + i] = OldAdded[Order[i]];
+				Changed[Offset + i] = OldChanged[Order[i]];
+			}
+
+			// Entries crossed chunk boundaries: recompute the stamps of every touched chunk.
+			const int32 FirstChunk = Offset / ChunkSize;
+			const int32 LastChunk = (Offset + Order.Num() - 1) / ChunkSize;
+			for (int32 Chunk = FirstChunk; Chunk <= LastChunk; ++Chunk)
+			{
+				const int32 Begin = Chunk * ChunkSize;
+				const int32 End = FMath::Min(Begin + ChunkSize, Changed.Num());
+
+				uint32 Newest = 0;
+				for (int32 i = Begin; i < End; ++i)
+				{
+					Newest = FMath::Max(Newest, Changed[i]);
+				}
+				ChunkChanged[Chunk] = Newest;
+			}
+		}
+
+		/** Replaces every stamp with Count entries added at Tick (used when a storage is restored in bulk). */
+		void ResetTo(int32 Count, uint32 Tick)
+		{
+			Added.Init(Tick, Count);
+			Changed.Init(Tick, Count);
+			ChunkChanged.Init(Tick, (Count + ChunkSize - 1) / ChunkSize);
+		}
+
+		bool IsAddedSince(int32 Index, uint32 SinceTick) const { return Added[Index] > SinceTick; }
+		bool IsChangedSince(int32 Index, uint32 SinceTick) const { return Changed[Index] > SinceTick; }
+		bool IsChunkChangedSince(int32 Chunk, uint32 SinceTick) const { return ChunkChanged[Chunk] > SinceTick; }
+	};
+
 	/**
 	 * Base class for component storage.
 	 *
@@ -19,6 +138,106 @@ namespace Kz::ECS
 		virtual void Remove(const Entity& E) = 0;
 		virtual int32 Num() const = 0;
 		virtual const TArray<Entity>& GetEntities() const = 0;
+		virtual int32 GetDenseIndex(const Entity& E) const = 0;
+		virtual const FComponentTicks& GetTicks() const = 0;
+
+		/** Swaps two dense entries, keeping the sparse lookup consistent. */
+		virtual void SwapDenseEntries(int32 A, int32 B) = 0;
+
+		/**
+		 * Reorders the dense range [Offset, Offset + Order.Num()).
+		 * Order[i] is the position (relative to Offset) of the entry that moves to Offset + i.
+		 */
+		virtual void ApplyPermutation(int32 Offset, TArrayView<const int32> Order) = 0;
+
+		/** Removes every component at once. */
+		virtual void Clear() = 0;
+
+		/** Whether Serialize() can round-trip this storage (see Storage<T>::bSerializable). */
+		virtual bool CanSerialize() const = 0;
+
+		/**
+		 * Saves or loads the dense arrays (entities + components) in one block.
+		 * Loading replaces the whole content and rebuilds the sparse lookup; every loaded
+		 * component is stamped as added at the current tick.
+		 */
+		virtual void Serialize(FArchive& Ar) = 0;
+	};
+
+	/**
+	 * Bookkeeping for an owning group (see TGroup).
+	 *
+	 * Entities that own every component of the group are kept packed at the front of each owned
+	 * storage, in the same order, so the group can walk all dense arrays in lockstep. A storage can
+	 * be owned by at most one group. Owned storages notify the group after adding a component and
+	 * before removing one, and the group swaps the entity into or out of the shared prefix.
+	 */
+	struct FOwningGroup
+	{
+		TArray<IStorage*, TInlineAllocator<4>> Owned;
+
+		/** Number of entities currently in the group, i.e. the length of the shared prefix. */
+		int32 Size = 0;
+
+		bool OwnsAll(const Entity& E) const
+		{
+			for (const IStorage* S : Owned)
+			{
+				if (S->GetDenseIndex(E) == INDEX_NONE)
+					return false;
+			}
+			return true;
+		}
+
+		/** Called by an owned storage right after E received a new component. */
+		void OnAdd(const Entity& E)
+		{
+			if (!OwnsAll(E) || Owned[0]->GetDenseIndex(E) < Size)
+				return;
+
+			for (IStorage* S : Owned)
+			{
+				S->SwapDenseEntries(S->GetDenseIndex(E), Size);
+			}
+			++Size;
+		}
+
+		/** Called by an owned storage right before E loses its component. */
+		void OnRemove(const Entity& E)
+		{
+			const int32 Index = Owned[0]->GetDenseIndex(E);
+			if (Index == INDEX_NONE || Index >= Size)
+				return;
+
+			--Size;
+			for (IStorage* S : Owned)
+			{
+				S->SwapDenseEntries(S->GetDenseIndex(E), Size);
+			}
+		}
+
+		/** Packs every existing qualifying entity into the prefix. Used when the group is created. */
+		void Build()
+		{
+			Size = 0;
+
+			// OnAdd only ever swaps a visited entry into position i, so a single forward pass is enough.
+			const TArray<Entity>& Entities = Owned[0]->GetEntities();
+			for (int32 i = 0; i < Entities.Num(); ++i)
+			{
+				OnAdd(Entities[i]);
+			}
+		}
+
+		/** Applies the same reorder of the group prefix to every owned storage. */
+		void ApplyPermutation(TArrayView<const int32> Order)
+		{
+			check(Order.Num() == Size);
+			for (IStorage* S : Owned)
+			{
+				S->ApplyPermutation(0, Order);
+			}
+		}
 	};
 
 	struct FEmptyStorage : IStorage
@@ -31,6 +250,17 @@ namespace Kz::ECS
 			static TArray<Entity> Empty;
 			return Empty;
 		}
+		virtual int32 GetDenseIndex(const Entity&) const override { return INDEX_NONE; }
+		virtual const FComponentTicks& GetTicks() const override
+		{
+			static FComponentTicks Empty;
+			return Empty;
+		}
+		virtual void SwapDenseEntries(int32, int32) override {}
+		virtual void ApplyPermutation(int32, TArrayView<const int32>) override {}
+		virtual void Clear() override {}
+		virtual bool CanSerialize() const override { return false; }
+		virtual void Serialize(FArchive&) override {}
 	};
 
 	/**
@@ -41,37 +271,117 @@ namespace Kz::ECS
 	 *     - Components[] : tightly-packed array of component values
 	 *     - Entities[]   : parallel array of owning entities
 	 *   Sparse:
-	 *     - Lookup map: Entity -> dense index
+	 *     - Paged lookup: Entity Index -> dense index
 	 *
 	 * Dense arrays guarantee cache-friendly iteration.
-	 * Lookup map enables O(1) access for Get/Contains.
+	 * The sparse side is split into fixed-size pages allocated on demand, so a storage only
+	 * pays for the index ranges its entities actually live in. A rare component attached to a
+	 * single high-index entity costs one page, not a table sized to the highest entity index.
+	 *
+	 * Each component also carries added/changed tick stamps (see FComponentTicks). Adds and
+	 * overwrites stamp automatically; writes made through a raw reference must be reported
+	 * with MarkChanged().
 	 */
 	template<typename T>
 	class Storage : public IStorage
 	{
 	public:
+		/** Number of entity indices covered by a single sparse page. */
+		static constexpr int32 SparsePageSize = 1024;
+
+		/**
+		 * Trivially copyable components are snapshotted as raw memory (pointers included, so such
+		 * snapshots are only meaningful within the running process). Other components need either
+		 * operator<<(FArchive&, T&) or a reflected StaticStruct(), plus a default constructor.
+		 */
+		static constexpr bool bTriviallySerializable = std::is_trivially_copyable_v<T>;
+		static constexpr bool bSerializable = bTriviallySerializable || (std::is_default_constructible_v<T> &&
+			(requires(FArchive& Ar, T& Value) { Ar << Value; } || requires { T::StaticStruct(); }));
+
 		/**
 		 * Adds or overwrites the component for the given entity.
 		 */
 		T& Add(const Entity& E, const T& Value)
 		{
-			EnsureCapacity(E.Index);
-			
-			const int32 DenseIndex = Sparse[E.Index];
-			if (DenseIndex != INDEX_NONE && DenseIndex < Components.Num())
+			return Emplace(E, Value);
+		}
+
+		/**
+		 * Adds or overwrites the component for the given entity, moving Value in.
+		 */
+		T& Add(const Entity& E, T&& Value)
+		{
+			return Emplace(E, MoveTemp(Value));
+		}
+
+		/**
+		 * Constructs the component in place for the given entity.
+		 * If the entity already owns one, it is overwritten with a freshly constructed value.
+		 */
+		template<typename... ArgTypes>
+		T& Emplace(const Entity& E, ArgTypes&&... Args)
+		{
+			int32& DenseIndex = GetOrAllocSparse(E.Index);
+			if (DenseIndex != INDEX_NONE)
 			{
 				// Already exists, overwrite
 				T& Ref = Components[DenseIndex];
-				Ref = Value;
+				Ref = T(Forward<ArgTypes>(Args)...);
+				Ticks.MarkChanged(DenseIndex, GetCurrentTick());
 				return Ref;
 			}
 
 			// New component
-			const int32 NewIndex = Components.Add(Value);
+			DenseIndex = Components.Emplace(Forward<ArgTypes>(Args)...);
 			Entities.Add(E);
-			Sparse[E.Index] = NewIndex;
+			Ticks.Push(GetCurrentTick());
+
+			// May move the new entry into the group prefix; DenseIndex aliases the sparse slot and follows it.
+			if (OwningGroup)
+			{
+				OwningGroup->OnAdd(E);
+			}
 
-			return Components[NewIndex];
+			return Components[DenseIndex];
+		}
+
+		/**
+		 * Adds (or overwrites) a copy of Value for every entity in the list.
+		 * Dense arrays are grown once up-front instead of per entity.
+		 */
+		void AddMany(TArrayView<const Entity> InEntities, const T& Value)
+		{
+			Reserve(Components.Num() + InEntities.Num());
+
+			for (const Entity& E : InEntities)
+			{
+				Emplace(E, Value);
+			}
+		}
+
+		/**
+		 * Adds (or overwrites) one value per entity. Both views must have the same length.
+		 */
+		void AddMany(TArrayView<const Entity> InEntities, TArrayView<const T> Values)
+		{
+			check(InEntities.Num() == Values.Num());
+			Reserve(Components.Num() + InEntities.Num());
+
+			for (int32 i = 0; i < InEntities.Num(); ++i)
+			{
+				Emplace(InEntities[i], Values[i]);
+			}
+		}
+
+		/**
+		 * Preallocates dense storage for at least Number components.
+		 * Sparse pages are still allocated lazily as entities are added.
+		 */
+		void Reserve(int32 Number)
+		{
+			Components.Reserve(Number);
+			Entities.Reserve(Number);
+			Ticks.Reserve(Number);
 		}
 
 		/**
@@ -81,31 +391,125 @@ namespace Kz::ECS
 		 */
 		virtual void Remove(const Entity& E) override
 		{
-			if (!Contains(E)) return;
+			int32* Slot = FindSparse(E.Index);
+			if (!Slot || *Slot == INDEX_NONE) return;
+
+			// Leave the group first so the swap-remove below never touches the packed prefix.
+			if (OwningGroup)
+			{
+				OwningGroup->OnRemove(E);
+			}
 
-			const int32 Index = Sparse[E.Index];
+			// Listeners run while the component is still readable.
+			if (RemovedDelegate.IsBound())
+			{
+				RemovedDelegate.Broadcast(E);
+			}
+
+			const int32 Index = *Slot;
 			const int32 LastIndex = Components.Num() - 1;
 
 			// If we are removing the last element, no swap needed (just pop)
 			if (Index != LastIndex)
 			{
 				// Move last element into the removed slot
-				Components[Index] = Components[LastIndex];
-				Entity LastEntity = Entities[LastIndex];
+				Components[Index] = MoveTemp(Components[LastIndex]);
+				const Entity LastEntity = Entities[LastIndex];
 
 				Entities[Index] = LastEntity;
-				
-				// Update sparse array for the moved entity
-				// Using E.Index for the entity we are removing is correct, 
-				// but we need to update the entry for LastEntity.
-				Sparse[LastEntity.Index] = Index;
+
+				// Update sparse entry for the moved entity
+				*FindSparse(LastEntity.Index) = Index;
 			}
 
-			Components.Pop();
-			Entities.Pop();
+			Components.Pop(EAllowShrinking::No);
+			Entities.Pop(EAllowShrinking::No);
+			Ticks.RemoveAtSwap(Index);
 
 			// Mark slot as empty
-			Sparse[E.Index] = INDEX_NONE;
+			*Slot = INDEX_NONE;
+		}
+
+		virtual void Clear() override
+		{
+			if (RemovedDelegate.IsBound())
+			{
+				for (const Entity& E : Entities)
+				{
+					RemovedDelegate.Broadcast(E);
+				}
+			}
+
+			for (const Entity& E : Entities)
+			{
+				*FindSparse(E.Index) = INDEX_NONE;
+			}
+
+			Components.Reset();
+			Entities.Reset();
+			Ticks.ResetTo(0, 0);
+
+			// An empty prefix is trivially packed in every other owned storage.
+			if (OwningGroup)
+			{
+				OwningGroup->Size = 0;
+			}
+		}
+
+		virtual bool CanSerialize() const override { return bSerializable; }
+
+		virtual void Serialize(FArchive& Ar) override
+		{
+			if constexpr (bSerializable)
+			{
+				int32 Count = Components.Num();
+				Ar << Count;
+
+				if (Ar.IsLoading())
+				{
+					Clear();
+
+					if constexpr (bTriviallySerializable)
+					{
+						Components.SetNumUninitialized(Count);
+					}
+					else
+					{
+						Components.SetNum(Count);
+					}
+					Entities.SetNumUninitialized(Count);
+				}
+
+				Ar.Serialize(Entities.GetData(), (int64)Count * sizeof(Entity));
+
+				if constexpr (bTriviallySerializable)
+				{
+					Ar.Serialize(Components.GetData(), (int64)Count * sizeof(T));
+				}
+				else
+				{
+					for (T& Component : Components)
+					{
+						if constexpr (requires(FArchive& InAr, T& Value) { InAr << Value; })
+						{
+							Ar << Component;
+						}
+						else
+						{
+							T::StaticStruct()->SerializeItem(Ar, &Component, nullptr);
+						}
+					}
+				}
+
+				if (Ar.IsLoading())
+				{
+					for (int32 i = 0; i < Count; ++i)
+					{
+						GetOrAllocSparse(Entities[i].Index) = i;
+					}
+					Ticks.ResetTo(Count, GetCurrentTick());
+				}
+			}
 		}
 
 		/**
@@ -113,7 +517,7 @@ namespace Kz::ECS
 		 */
 		bool Contains(const Entity& E) const
 		{
-			return E.Index >= 0 && E.Index < Sparse.Num() && Sparse[E.Index] != INDEX_NONE;
+			return GetDenseIndex(E) != INDEX_NONE;
 		}
 
 		/**
@@ -123,24 +527,39 @@ namespace Kz::ECS
 		T& Get(const Entity& E)
 		{
 			// Assumes Contains(E) is true or checked by caller (Registry checks IsAlive)
-			return Components[Sparse[E.Index]];
+			return Components[GetDenseIndex(E)];
 		}
 
 		const T& Get(const Entity& E) const
 		{
-			return Components[Sparse[E.Index]];
+			return Components[GetDenseIndex(E)];
 		}
 
 		T* Find(const Entity& E)
 		{
-			return Contains(E) ? &Components[Sparse[E.Index]] : nullptr;
+			const int32 DenseIndex = GetDenseIndex(E);
+			return DenseIndex != INDEX_NONE ? &Components[DenseIndex] : nullptr;
 		}
 
 		const T* Find(const Entity& E) const
 		{
-			return Contains(E) ? &Components[Sparse[E.Index]] : nullptr;
+			const int32 DenseIndex = GetDenseIndex(E);
+			return DenseIndex != INDEX_NONE ? &Components[DenseIndex] : nullptr;
 		}
 
+		/**
+		 * Returns the dense index of the entity's component, or INDEX_NONE if it has none.
+		 */
+		virtual int32 GetDenseIndex(const Entity& E) const override
+		{
+			const int32* Slot = const_cast<Storage*>(this)->FindSparse(E.Index);
+			return Slot ? *Slot : INDEX_NONE;
+		}
+
+		/** Direct access by dense index (used by groups to walk storages in lockstep). */
+		T& GetByIndex(int32 DenseIndex) { return Components[DenseIndex]; }
+		const T& GetByIndex(int32 DenseIndex) const { return Components[DenseIndex]; }
+
 		/**
 		 * Number of components stored.
 		 */
@@ -155,25 +574,173 @@ namespace Kz::ECS
 		const TArray<T>& GetComponents() const { return Components; }
 		const TArray<Entity>& GetEntities() const { return Entities; }
 
-	private:
-		TArray<T> Components;         // Dense component array
-		TArray<Entity> Entities;      // Dense owner list
-		TArray<int32> Sparse;         // Sparse: Entity Index -> Dense Index
+		// ============================================================
+		//  Change tracking
+		// ============================================================
 
-		void EnsureCapacity(int32 EntityIndex)
+		/**
+		 * Stamps the entity's component as changed at the current world tick.
+		 * Call this after writing through a reference obtained from a view or Get().
+		 */
+		void MarkChanged(const Entity& E)
 		{
-			if (EntityIndex >= Sparse.Num())
+			const int32 DenseIndex = GetDenseIndex(E);
+			if (DenseIndex != INDEX_NONE)
 			{
-				const int32 OldNum = Sparse.Num();
-				const int32 NewNum = EntityIndex + 1;
-				Sparse.SetNum(NewNum);
-				
-				// Initialize new slots to INDEX_NONE
-				for (int32 i = OldNum; i < NewNum; ++i)
+				Ticks.MarkChanged(DenseIndex, GetCurrentTick());
+			}
+		}
+
+		virtual const FComponentTicks& GetTicks() const override { return Ticks; }
+
+		// ============================================================
+		//  Ordering
+		// ============================================================
+
+		/**
+		 * Sorts the dense arrays with Predicate(const T&, const T&), e.g. by a spatial key for locality.
+		 *
+		 * If the storage is owned by a group, the group prefix is sorted as a unit and the same
+		 * order is applied to every owned storage, keeping lockstep iteration valid. The entries
+		 * outside the group are sorted separately after it.
+		 */
+		template<typename Predicate>
+		void Sort(Predicate Pred)
+		{
+			const int32 GroupSize = OwningGroup ? OwningGroup->Size : 0;
+
+			if (GroupSize > 1)
+			{
+				OwningGroup->ApplyPermutation(MakeSortedOrder(0, GroupSize, Pred));
+			}
+
+			if (Num() - GroupSize > 1)
+			{
+				ApplyPermutation(GroupSize, MakeSortedOrder(GroupSize, Num() - GroupSize, Pred));
+			}
+		}
+
+		virtual void SwapDenseEntries(int32 A, int32 B) override
+		{
+			if (A == B)
+				return;
+
+			::Swap(Components[A], Components[B]);
+			::Swap(Entities[A], Entities[B]);
+			Ticks.Swap(A, B);
+
+			*FindSparse(Entities[A].Index) = A;
+			*FindSparse(Entities[B].Index) = B;
+		}
+
+		virtual void ApplyPermutation(int32 Offset, TArrayView<const int32> Order) override
+		{
+			TArray<T> Moved;
+			TArray<Entity> MovedEntities;
+			Moved.Reserve(Order.Num());
+			MovedEntities.Reserve(Order.Num());
+
+			for (const int32 From : Order)
+			{
+				Moved.Add(MoveTemp(Components[Offset + From]));
+				MovedEntities.Add(Entities[Offset + From]);
+			}
+
+			for (int32 i = 0; i < Order.Num(); ++i)
+			{
+				Components[Offset + i] = MoveTemp(Moved[i]);
+				Entities[Offset + i] = MovedEntities[i];
+				*FindSparse(MovedEntities[i].Index) = Offset + i;
+			}
+
+			Ticks.ApplyPermutation(Offset, Order);
+		}
+
+		/** Binds the storage to the group that owns it (done by the registry). */
+		void SetOwningGroup(FOwningGroup* InGroup) { OwningGroup = InGroup; }
+		FOwningGroup* GetOwningGroup() const { return OwningGroup; }
+
+		/** Fired just before an entity's component is removed (explicitly or by DestroyEntity). */
+		TMulticastDelegate<void(const Entity&)>& OnRemoved() { return RemovedDelegate; }
+
+		/** Binds the storage to its owning registry's tick counter (done by the registry). */
+		void SetTickSource(const uint32* InWorldTick) { WorldTick = InWorldTick; }
+
+		uint32 GetCurrentTick() const { return WorldTick ? *WorldTick : 0; }
+
+	private:
+		/** A fixed block of sparse entries, every slot initialised to INDEX_NONE. */
+		struct FSparsePage
+		{
+			int32 Indices[SparsePageSize];
+
+			FSparsePage()
+			{
+				for (int32& Index : Indices)
 				{
-					Sparse[i] = INDEX_NONE;
+					Index = INDEX_NONE;
 				}
 			}
+		};
+
+		TArray<T> Components;                        // Dense component array
+		TArray<Entity> Entities;                     // Dense owner list
+		TArray<TUniquePtr<FSparsePage>> SparsePages; // Sparse: Entity Index -> Dense Index, paged
+		FComponentTicks Ticks;                       // Dense: added/changed stamps
+		const uint32* WorldTick = nullptr;           // Owning registry's tick counter
+		FOwningGroup* OwningGroup = nullptr;         // Group keeping this storage's prefix packed, if any
+		TMulticastDelegate<void(const Entity&)> RemovedDelegate;
+
+		/** Returns the relative order that sorts [Offset, Offset + Count) by Pred. */
+		template<typename Predicate>
+		TArray<int32> MakeSortedOrder(int32 Offset, int32 Count, Predicate& Pred) const
+		{
+			TArray<int32> Order;
+			Order.SetNumUninitialized(Count);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Order[i] = i;
+			}
+
+			Order.Sort([this, Offset, &Pred](int32 A, int32 B)
+			{
+				return ::Invoke(Pred, Components[Offset + A], Components[Offset + B]);
+			});
+
+			return Order;
+		}
+
+		/** Returns the sparse slot for EntityIndex, or nullptr if its page was never allocated. */
+		int32* FindSparse(int32 EntityIndex)
+		{
+			if (EntityIndex < 0)
+				return nullptr;
+
+			const int32 PageIndex = EntityIndex / SparsePageSize;
+			if (PageIndex >= SparsePages.Num() || !SparsePages[PageIndex].IsValid())
+				return nullptr;
+
+			return &SparsePages[PageIndex]->Indices[EntityIndex % SparsePageSize];
+		}
+
+		/** Returns the sparse slot for EntityIndex, allocating its page if needed. */
+		int32& GetOrAllocSparse(int32 EntityIndex)
+		{
+			check(EntityIndex >= 0);
+
+			const int32 PageIndex = EntityIndex / SparsePageSize;
+			if (PageIndex >= SparsePages.Num())
+			{
+				SparsePages.SetNum(PageIndex + 1);
+			}
+
+			TUniquePtr<FSparsePage>& Page = SparsePages[PageIndex];
+			if (!Page.IsValid())
+			{
+				Page = MakeUnique<FSparsePage>();
+			}
+
+			return Page->Indices[EntityIndex % SparsePageSize];
 		}
 	};
 
@@ -33,13 +33,19 @@ namespace Kz::ECS
 
 		/**
 		 * Updates all systems in the order they were added.
+		 *
+		 * The registry tick is advanced before each system and once more after the last one, so
+		 * changes made by a system, or outside the group between updates, always carry a newer stamp
+		 * than the tick any system recorded as its last run (Registry.GetTick() at the end of its Update).
 		 */
 		void Update(float DeltaTime)
 		{
 			for (const auto& System : Systems)
 			{
+				R.AdvanceTick();
 				System->Update(DeltaTime, R);
 			}
+			R.AdvanceTick();
 		}
 
 	private:
@@ -16,6 +16,28 @@ namespace Kz::ECS
 	template<typename... Components>
 	using ConstView = TView<true, TTuple<Components...>, TTuple<>>;
 
+	/** Keeps entities whose added/changed stamp in Storage is newer than SinceTick. */
+	struct FTickFilter
+	{
+		const IStorage* Storage = nullptr;
+		uint32 SinceTick = 0;
+		bool bAdded = false;
+
+		bool Passes(int32 DenseIndex) const
+		{
+			if (DenseIndex == INDEX_NONE)
+				return false;
+
+			const FComponentTicks& Ticks = Storage->GetTicks();
+			return bAdded ? Ticks.IsAddedSince(DenseIndex, SinceTick) : Ticks.IsChangedSince(DenseIndex, SinceTick);
+		}
+
+		bool PassesChunk(int32 Chunk) const
+		{
+			return Storage->GetTicks().IsChunkChangedSince(Chunk, SinceTick);
+		}
+	};
+
 	/**
 	 * Iterates efficiently over all entities that contain ALL specified components.
 	 * Automatically selects the smallest storage as the iteration base for performance.
@@ -23,33 +45,36 @@ namespace Kz::ECS
 	 * Example:
 	 *   for (auto [e, pos, vel] : registry.View<Position, Velocity>())
 	 *   { ... }
+	 *
+	 * Views can additionally be narrowed to components added or changed after a given tick
+	 * (see Changed() / Added()). The filtered storage then becomes the iteration base and
+	 * whole chunks with no recent change are skipped, so reactive systems cost O(changed).
 	 */
 	template<bool bConst, typename... Included, typename... Excluded>
 	class TView<bConst, TTuple<Included...>, TTuple<Excluded...>>
 	{
+		template<bool, typename, typename>
+		friend class TView;
+
 	public:
 		template<typename T>
 		using CompRef = std::conditional_t<bConst, const T&, T&>;
 
+		template<typename T>
+		using StoragePtr = std::conditional_t<bConst, const Storage<T>*, Storage<T>*>;
+
 		/** Construct a view bound to a registry instance. */
 		TView(Registry& InRegistry)
 			: R(InRegistry)
+			, IncludedStorages(InRegistry.GetStorage<Included>()...)
+			, ExcludedStorages(InRegistry.GetStorage<Excluded>()...)
 		{
 			InitBaseStorage();
 		}
 
 		bool IsEntityValid(const Entity& E) const
 		{
-			if (!((R.HasComponent<Included>(E)) && ...))
-				return false;
-
-			if constexpr (sizeof...(Excluded) > 0)
-			{
-				if (((R.HasComponent<Excluded>(E)) || ...))
-					return false;
-			}
-
-			return true;
+			return HasRequiredComponents(E) && PassesFilters(E, 0);
 		}
 
 		/**
@@ -71,7 +96,45 @@ namespace Kz::ECS
 		template<typename... MoreExcluded>
 		auto Exclude() const
 		{
-			return TView<bConst, TTuple<Included...>, TTuple<Excluded..., MoreExcluded...>>(R);
+			TView<bConst, TTuple<Included...>, TTuple<Excluded..., MoreExcluded...>> Result(R);
+			for (const FTickFilter& Filter : Filters)
+			{
+				Result.AddFilter(Filter);
+			}
+			return Result;
+		}
+
+		/**
+		 * Returns a new view restricted to entities whose T component changed after SinceTick.
+		 * Adding a component counts as a change.
+		 *
+		 * A reactive system typically remembers the tick it last ran at:
+		 *
+		 * for (auto [e, target] : Registry.View<FTarget>().Changed<FTarget>(LastRunTick))
+		 * {
+		 *     Repath(e, target);
+		 * }
+		 * LastRunTick = Registry.GetTick();
+		 *
+		 * @param SinceTick  Only stamps strictly greater than this tick pass.
+		 */
+		template<typename T>
+		TView Changed(uint32 SinceTick) const
+		{
+			TView Result(*this);
+			Result.AddFilter(FTickFilter{ R.GetStorage<T>(), SinceTick, false });
+			return Result;
+		}
+
+		/**
+		 * Returns a new view restricted to entities whose T component was added after SinceTick.
+		 */
+		template<typename T>
+		TView Added(uint32 SinceTick) const
+		{
+			TView Result(*this);
+			Result.AddFilter(FTickFilter{ R.GetStorage<T>(), SinceTick, true });
+			return Result;
 		}
 
 		/** Calls a lambda for each entity in the view. */
@@ -101,13 +164,17 @@ namespace Kz::ECS
 
 			ParallelFor(Count, [this, &F](int32 Index)
 			{
-				Entity E = Base->GetEntities()[Index];
+				if (Filters.Num() > 0 && !Filters[0].PassesChunk(Index / FComponentTicks::ChunkSize))
+				{
+					return;
+				}
 
-				if (!IsEntityValid(E))
+				if (!IsIndexValid(Index))
 				{
 					return;
 				}
 
+				const Entity E = Base->GetEntities()[Index];
 				F(E, GetComponent<Included>(E)...);
 			});
 		}
@@ -118,10 +185,10 @@ namespace Kz::ECS
 		struct Iterator
 		{
 			TView& View;
-			IStorage* Base;
+			const IStorage* Base;
 			int32 Index;
 
-			Iterator(TView& InView, IStorage* InBase, int32 InIndex)
+			Iterator(TView& InView, const IStorage* InBase, int32 InIndex)
 				: View(InView), Base(InBase), Index(InIndex)
 			{
 				AdvanceToValid();
@@ -153,22 +220,32 @@ namespace Kz::ECS
 			}
 
 		private:
-			// Check that entity has all components.
+			// Check that entity has all components and passes every tick filter.
 			void AdvanceToValid()
 			{
 				if (!Base)
 					return;
 
+				constexpr int32 ChunkSize = FComponentTicks::ChunkSize;
 				const int32 Count = Base->Num();
+
 				while (Index < Count)
 				{
-					Entity E = Base->GetEntities()[Index];
-
-					if (View.IsEntityValid(E))
+					// Skip whole chunks of the base storage that saw no change since the filter tick.
+					if (View.Filters.Num() > 0 && (Index % ChunkSize) == 0 && !View.Filters[0].PassesChunk(Index / ChunkSize))
+					{
+						Index += ChunkSize;
+						continue;
+					}
+
+					if (View.IsIndexValid(Index))
 						return;
 
 					++Index;
 				}
+
+				// Chunk skipping can overshoot; clamp so we compare equal to end().
+				Index = Count;
 			}
 		};
 
@@ -185,8 +262,15 @@ namespace Kz::ECS
 	private:
 		Registry& R;
 
-		// Base storage (the smallest)
-		IStorage* Base = nullptr;
+		// Cached storages, resolved once at construction instead of per access.
+		TTuple<StoragePtr<Included>...> IncludedStorages;
+		TTuple<const Storage<Excluded>*...> ExcludedStorages;
+
+		// Base storage (the smallest, or the first filtered one)
+		const IStorage* Base = nullptr;
+
+		// Tick filters. When present, Filters[0] acts on the base storage (enables chunk skipping).
+		TArray<FTickFilter, TInlineAllocator<2>> Filters;
 
 		/**
 		 * Select the smallest storage to iterate.
@@ -195,8 +279,33 @@ namespace Kz::ECS
 		{
 			Base = nullptr;
 
+			static FEmptyStorage EmptyStorage;
+
+			// A missing required storage means no entity can match.
+			if (!((GetStorage<Included>() != nullptr) && ...))
+			{
+				Base = &EmptyStorage;
+				return;
+			}
+
+			// Iterating a filtered storage lets us skip unchanged chunks wholesale.
+			if (Filters.Num() > 0)
+			{
+				for (const FTickFilter& Filter : Filters)
+				{
+					if (!Filter.Storage)
+					{
+						Base = &EmptyStorage;
+						return;
+					}
+				}
+
+				Base = Filters[0].Storage;
+				return;
+			}
+
 			// Helper lambda: considers each storage and selects the smallest
-			auto Consider = [&](IStorage* S)
+			auto Consider = [&](const IStorage* S)
 			{
 				if (S && (!Base || S->Num() < Base->Num()))
 				{
@@ -205,20 +314,73 @@ namespace Kz::ECS
 			};
 
 			// Expands over all types of Components...
-			(Consider(R.GetStorage<Included>()), ...);
+			(Consider(GetStorage<Included>()), ...);
 
 			// If no storage exists, produce an empty view
 			if (!Base)
 			{
-				static FEmptyStorage EmptyStorage;
 				Base = &EmptyStorage;
 			}
 		}
 
+		void AddFilter(const FTickFilter& Filter)
+		{
+			Filters.Add(Filter);
+			InitBaseStorage();
+		}
+
+		bool HasRequiredComponents(const Entity& E) const
+		{
+			if (!((GetStorage<Included>() && GetStorage<Included>()->Contains(E)) && ...))
+				return false;
+
+			if constexpr (sizeof...(Excluded) > 0)
+			{
+				if (((IsExcludedPresent<Excluded>(E)) || ...))
+					return false;
+			}
+
+			return true;
+		}
+
+		bool PassesFilters(const Entity& E, int32 FirstFilter) const
+		{
+			for (int32 i = FirstFilter; i < Filters.Num(); ++i)
+			{
+				if (!Filters[i].Passes(Filters[i].Storage->GetDenseIndex(E)))
+					return false;
+			}
+			return true;
+		}
+
+		/** Full validity test for the entity at a dense index of the base storage. */
+		bool IsIndexValid(int32 Index) const
+		{
+			// The base filter reads its stamp by dense index directly; no sparse lookup needed.
+			if (Filters.Num() > 0 && !Filters[0].Passes(Index))
+				return false;
+
+			const Entity& E = Base->GetEntities()[Index];
+			return HasRequiredComponents(E) && PassesFilters(E, 1);
+		}
+
+		template<typename T>
+		StoragePtr<T> GetStorage() const
+		{
+			return IncludedStorages.template Get<TTupleIndex<T, TTuple<Included...>>::Value>();
+		}
+
+		template<typename T>
+		bool IsExcludedPresent(const Entity& E) const
+		{
+			const Storage<T>* S = ExcludedStorages.template Get<TTupleIndex<T, TTuple<Excluded...>>::Value>();
+			return S && S->Contains(E);
+		}
+
 		template<typename T>
 		CompRef<T> GetComponent(const Entity& E) const
 		{
-			return R.GetComponent<T>(E);
+			return GetStorage<T>()->Get(E);
 		}
 	};
 } // namespace Kz::ECS
\ No newline at end of file
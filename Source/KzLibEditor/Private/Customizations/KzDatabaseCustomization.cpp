@@ -144,6 +144,8 @@ void FKzDatabaseCustomization::OnItemsArrayChanged()
 		{
 			Item.SyncType(DB->Type);
 		}
+
+		DB->InvalidateIndex();
 	}
 }
 